@@ -0,0 +1,71 @@
+// Benchmark: HomomorphicInt::encryptMany / decryptMany ops/sec by threads
+//
+// Usage: bench_batch [count]
+
+#include "bench_utils.hpp"
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+#include <thread>
+
+using sealcrypt::bench::timeMs;
+
+auto main(int argc, char* argv[]) -> int {
+  const int count = sealcrypt::bench::iterations(argc, argv, 2000);
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Low);
+  sealcrypt::KeyPair keys(ctx);
+  if(!ctx.isValid() || !keys.generate()) {
+    std::fprintf(stderr, "setup failed\n");
+    return 1;
+  }
+
+  std::vector< std::int64_t > values(count);
+  for(int i = 0; i < count; ++i) {
+    values[i] = i;
+  }
+  std::vector< sealcrypt::HomomorphicInt > encrypted(count);
+  std::vector< std::int64_t > decrypted(count);
+
+  std::printf("Low, %d values, %u hardware threads\n",
+              count,
+              std::thread::hardware_concurrency());
+  std::printf("%-8s %14s %14s %10s %10s\n",
+              "threads",
+              "enc ops/s",
+              "dec ops/s",
+              "enc x",
+              "dec x");
+
+  double enc_base = 0;
+  double dec_base = 0;
+  for(std::size_t threads : {1u, 2u, 4u, 8u, 16u}) {
+    double enc_ms = timeMs([&] {
+      sealcrypt::HomomorphicInt::encryptMany(
+          values.data(), values.size(), encrypted.data(), ctx, keys, threads);
+    });
+    double dec_ms = timeMs([&] {
+      sealcrypt::HomomorphicInt::decryptMany(encrypted.data(),
+                                             encrypted.size(),
+                                             decrypted.data(),
+                                             ctx,
+                                             keys,
+                                             threads);
+    });
+
+    double enc_ops = count / (enc_ms / 1000.0);
+    double dec_ops = count / (dec_ms / 1000.0);
+    if(threads == 1) {
+      enc_base = enc_ops;
+      dec_base = dec_ops;
+    }
+    std::printf("%-8zu %14.0f %14.0f %10.2f %10.2f%s\n",
+                threads,
+                enc_ops,
+                dec_ops,
+                enc_ops / enc_base,
+                dec_ops / dec_base,
+                decrypted == values ? "" : "  [MISMATCH]");
+  }
+  return 0;
+}
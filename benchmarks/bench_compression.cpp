@@ -0,0 +1,103 @@
+// Benchmark: serialized size and save/load throughput per Compression mode
+//
+// Usage: bench_compression [iterations]
+
+#include "bench_utils.hpp"
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+#include <sstream>
+
+using sealcrypt::bench::timeMs;
+
+namespace {
+
+  auto compressionName(sealcrypt::Compression mode) -> const char* {
+    switch(mode) {
+      case sealcrypt::Compression::Zlib: return "zlib";
+      case sealcrypt::Compression::Zstd: return "zstd";
+      default: return "none";
+    }
+  }
+
+  /// Save and reload object `iterations` times with the context's compression
+  template< class T >
+  void measure(const char* name,
+               const T& object,
+               const sealcrypt::CryptoContext& ctx,
+               int iterations) {
+    std::string bytes;
+    double save_ms = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        std::ostringstream out(std::ios::binary);
+        object.save(out, ctx.sealComprMode());
+        bytes = out.str();
+      }
+    });
+
+    T loaded;
+    double load_ms = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        std::istringstream in(bytes, std::ios::binary);
+        loaded.load(ctx.sealContext(), in);
+      }
+    });
+
+    // throughput in terms of serialized bytes
+    auto mb_per_s = [&](double ms) {
+      return static_cast< double >(bytes.size()) * iterations / 1e6 /
+             (ms / 1000.0);
+    };
+    std::printf("%-6s %-12s %12zu %12.1f %12.1f\n",
+                compressionName(ctx.compression()),
+                name,
+                bytes.size(),
+                mb_per_s(save_ms),
+                mb_per_s(load_ms));
+  }
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  const int iterations = sealcrypt::bench::iterations(argc, argv, 5);
+
+  for(auto level : {sealcrypt::SecurityLevel::Low,
+                    sealcrypt::SecurityLevel::Medium,
+                    sealcrypt::SecurityLevel::High}) {
+    sealcrypt::CryptoContext ctx(level);
+    sealcrypt::KeyPair keys(ctx);
+    if(!ctx.isValid() || !keys.generateAll()) {
+      std::fprintf(stderr, "setup failed\n");
+      return 1;
+    }
+
+    auto fresh = sealcrypt::HomomorphicInt::encrypt(12345, ctx, keys);
+    auto switched = fresh.ciphertext();
+    ctx.evaluator().mod_switch_to_inplace(switched,
+                                          ctx.sealContext().last_parms_id());
+
+    std::printf("\n%s\n", sealcrypt::bench::levelName(static_cast< int >(level))
+                              .c_str());
+    std::printf("%-6s %-12s %12s %12s %12s\n",
+                "mode",
+                "object",
+                "bytes",
+                "save MB/s",
+                "load MB/s");
+
+    for(auto mode : {sealcrypt::Compression::None,
+                     sealcrypt::Compression::Zlib,
+                     sealcrypt::Compression::Zstd}) {
+      if(!ctx.setCompression(mode)) {
+        std::printf("%-6s (not supported by this SEAL build)\n",
+                    compressionName(mode));
+        continue;
+      }
+      measure("ciphertext", fresh.ciphertext(), ctx, iterations);
+      measure("ct last lvl", switched, ctx, iterations);
+      measure("relin keys", keys.relinKeys(), ctx, iterations);
+      measure("galois keys", keys.galoisKeys(), ctx, iterations);
+    }
+  }
+  return 0;
+}
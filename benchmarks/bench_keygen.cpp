@@ -0,0 +1,63 @@
+// Benchmark: KeyPair::generateAll wall time per level, one thread vs all
+//
+// Usage: bench_keygen [iterations]
+
+#include "bench_utils.hpp"
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+#include <thread>
+
+using sealcrypt::bench::timeMs;
+
+auto main(int argc, char* argv[]) -> int {
+  const int iterations = sealcrypt::bench::iterations(argc, argv, 3);
+  const std::size_t hardware = std::thread::hardware_concurrency();
+
+  std::printf("%d iterations, %zu hardware threads\n", iterations, hardware);
+  std::printf("%-8s %8s %14s %14s %10s\n",
+              "level",
+              "galois",
+              "1 thread ms",
+              "all threads ms",
+              "speedup");
+
+  for(auto level : {sealcrypt::SecurityLevel::Low,
+                    sealcrypt::SecurityLevel::Medium,
+                    sealcrypt::SecurityLevel::High}) {
+    sealcrypt::CryptoContext ctx(level);
+    if(!ctx.isValid()) {
+      std::fprintf(stderr, "setup failed\n");
+      return 1;
+    }
+
+    auto generate = [&](std::size_t threads, std::size_t& galois) {
+      bool ok = true;
+      double ms = timeMs([&] {
+        for(int i = 0; i < iterations; ++i) {
+          sealcrypt::KeyPair keys(ctx);
+          keys.setThreadCount(threads);
+          ok = ok && keys.generateAll();
+          galois = keys.hasGaloisKeys() ? keys.galoisKeys().size() : 0;
+        }
+      });
+      return ok ? ms / iterations : -1.0;
+    };
+
+    std::size_t galois = 0;
+    double serial = generate(1, galois);
+    double parallel = generate(0, galois);
+    if(serial < 0 || parallel < 0) {
+      std::fprintf(stderr, "generateAll failed\n");
+      return 1;
+    }
+
+    std::printf("%-8s %8zu %14.1f %14.1f %10.2f\n",
+                sealcrypt::bench::levelName(static_cast< int >(level)).c_str(),
+                galois,
+                serial,
+                parallel,
+                serial / parallel);
+  }
+  return 0;
+}
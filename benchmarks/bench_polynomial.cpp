@@ -0,0 +1,107 @@
+// Benchmark: evaluatePolynomial() against Horner's rule, degrees 4 - 64
+//
+// Usage: bench_polynomial [iterations]
+//
+// Horner's depth grows with the degree, so at high degrees it runs out of
+// noise budget and decrypts wrong values ([MISMATCH]); the budget column
+// shows the bits left in each result.
+
+#include "bench_utils.hpp"
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+
+using sealcrypt::bench::timeMs;
+
+namespace {
+
+  /// ((c[n] * x + c[n-1]) * x + ...) + c[0], relinearizing every product
+  auto horner(const sealcrypt::HomomorphicInt& x,
+              const std::vector< std::int64_t >& coeffs,
+              const sealcrypt::CryptoContext& ctx,
+              const sealcrypt::KeyPair& keys) -> sealcrypt::HomomorphicInt {
+    auto acc = x.mulPlain(coeffs.back(), ctx)
+                   .addPlain(coeffs[coeffs.size() - 2], ctx);
+    for(std::size_t i = coeffs.size() - 2; i-- > 0;) {
+      acc = (std::move(acc) * x).relinearize(ctx, keys).addPlain(coeffs[i],
+                                                                 ctx);
+    }
+    return acc;
+  }
+
+  auto plainValue(const std::vector< std::int64_t >& coeffs,
+                  std::int64_t x,
+                  std::int64_t t) -> std::int64_t {
+    std::int64_t result = 0;
+    for(auto it = coeffs.rbegin(); it != coeffs.rend(); ++it) {
+      result = ((result * x + *it) % t + t) % t;
+    }
+    return result;
+  }
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  const int iterations = sealcrypt::bench::iterations(argc, argv, 3);
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::High);
+  sealcrypt::KeyPair keys(ctx);
+  if(!ctx.isValid() || !keys.generate() || !keys.generateRelinKeys()) {
+    std::fprintf(stderr, "setup failed\n");
+    return 1;
+  }
+  const auto t = static_cast< std::int64_t >(ctx.plainModulus());
+
+  const std::int64_t x = 2;
+  auto enc_x = sealcrypt::HomomorphicInt::encrypt(x, ctx, keys);
+
+  std::printf("High, mean of %d runs\n", iterations);
+  std::printf("%-7s %-8s %6s %6s %12s %8s\n",
+              "degree",
+              "method",
+              "mults",
+              "depth",
+              "ms",
+              "budget");
+
+  for(std::size_t degree : {4u, 8u, 16u, 32u, 64u}) {
+    std::vector< std::int64_t > coeffs(degree + 1);
+    for(std::size_t i = 0; i <= degree; ++i) {
+      coeffs[i] = static_cast< std::int64_t >(i % 7) + 1;
+    }
+    const auto expected = plainValue(coeffs, x, t);
+    const auto cost = sealcrypt::polynomialCost(degree);
+
+    sealcrypt::HomomorphicInt horner_result;
+    double horner_ms = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        horner_result = horner(enc_x, coeffs, ctx, keys);
+      }
+    });
+
+    sealcrypt::HomomorphicInt ps_result;
+    double ps_ms = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        ps_result = sealcrypt::evaluatePolynomial(enc_x, coeffs, ctx, keys);
+      }
+    });
+
+    auto report = [&](const char* method,
+                      std::size_t mults,
+                      std::size_t depth,
+                      double ms,
+                      const sealcrypt::HomomorphicInt& result) {
+      std::printf("%-7zu %-8s %6zu %6zu %12.2f %8d%s\n",
+                  degree,
+                  method,
+                  mults,
+                  depth,
+                  ms / iterations,
+                  result.noiseBudget(ctx, keys),
+                  result.decrypt(ctx, keys) == expected ? "" : "  [MISMATCH]");
+    };
+    report("horner", degree - 1, degree - 1, horner_ms, horner_result);
+    report("bsgs", cost.multiplications, cost.depth, ps_ms, ps_result);
+  }
+  return 0;
+}
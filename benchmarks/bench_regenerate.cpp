@@ -0,0 +1,79 @@
+// Benchmark: loading relin and Galois keys from disk vs regenerating them
+// from the secret key, per level
+//
+// Usage: bench_regenerate [iterations]
+
+#include "bench_utils.hpp"
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+using sealcrypt::bench::timeMs;
+
+auto main(int argc, char* argv[]) -> int {
+  const int iterations = sealcrypt::bench::iterations(argc, argv, 3);
+  const char* sec_path = "bench_regenerate_sec.key";
+  const char* relin_path = "bench_regenerate_relin.key";
+  const char* galois_path = "bench_regenerate_galois.key";
+
+  std::printf("%-8s %10s %12s %14s %10s\n",
+              "level",
+              "keys MB",
+              "load ms",
+              "regenerate ms",
+              "speedup");
+
+  for(auto level : {sealcrypt::SecurityLevel::Low,
+                    sealcrypt::SecurityLevel::Medium,
+                    sealcrypt::SecurityLevel::High}) {
+    sealcrypt::CryptoContext ctx(level);
+    sealcrypt::KeyPair keys(ctx);
+    if(!ctx.isValid() || !keys.generateAll() ||
+       !keys.saveSecretKey(sec_path) || !keys.saveRelinKeys(relin_path) ||
+       !keys.saveGaloisKeys(galois_path)) {
+      std::fprintf(stderr, "setup failed\n");
+      return 1;
+    }
+
+    // Both sides start from the secret key, only the evaluation keys
+    // differ
+    bool ok = true;
+    double load = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        sealcrypt::KeyPair loaded(ctx);
+        ok = ok && loaded.loadSecretKey(sec_path) &&
+             loaded.loadRelinKeys(relin_path) &&
+             loaded.loadGaloisKeys(galois_path);
+      }
+    });
+    double regenerate = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        sealcrypt::KeyPair rebuilt(ctx);
+        ok = ok && rebuilt.loadSecretKey(sec_path) &&
+             rebuilt.generateEvaluationKeys();
+      }
+    });
+    if(!ok) {
+      std::fprintf(stderr, "load or regenerate failed\n");
+      return 1;
+    }
+
+    namespace fs = std::filesystem;
+    const double mb
+        = static_cast< double >(fs::file_size(relin_path) +
+                                fs::file_size(galois_path)) /
+          (1024.0 * 1024.0);
+    std::printf("%-8s %10.1f %12.1f %14.1f %10.2f\n",
+                sealcrypt::bench::levelName(static_cast< int >(level)).c_str(),
+                mb,
+                load / iterations,
+                regenerate / iterations,
+                load / regenerate);
+  }
+
+  std::remove(sec_path);
+  std::remove(relin_path);
+  std::remove(galois_path);
+  return 0;
+}
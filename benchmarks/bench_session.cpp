@@ -0,0 +1,68 @@
+// Benchmark: per-call SEAL encryptor/decryptor vs cached CryptoSession
+//
+// Usage: bench_session [iterations]
+
+#include "bench_utils.hpp"
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+
+using sealcrypt::bench::timeMs;
+
+auto main(int argc, char* argv[]) -> int {
+  const int iterations = sealcrypt::bench::iterations(argc, argv, 200);
+
+  std::printf("%-8s %14s %14s %14s %14s\n",
+              "level",
+              "enc/call us",
+              "enc/session us",
+              "dec/call us",
+              "dec/session us");
+
+  for(auto level : {sealcrypt::SecurityLevel::Low,
+                    sealcrypt::SecurityLevel::Medium,
+                    sealcrypt::SecurityLevel::High}) {
+    sealcrypt::CryptoContext ctx(level);
+    sealcrypt::KeyPair keys(ctx);
+    if(!ctx.isValid() || !keys.generate()) {
+      std::fprintf(stderr, "setup failed\n");
+      return 1;
+    }
+    sealcrypt::CryptoSession session(ctx, keys);
+
+    std::vector< sealcrypt::HomomorphicInt > encrypted(iterations);
+
+    double enc_call = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        encrypted[i] = sealcrypt::HomomorphicInt::encrypt(i, ctx, keys);
+      }
+    });
+    double enc_session = timeMs([&] {
+      for(int i = 0; i < iterations; ++i) {
+        encrypted[i] = sealcrypt::HomomorphicInt::encrypt(i, session);
+      }
+    });
+
+    std::int64_t checksum = 0;
+    double dec_call = timeMs([&] {
+      for(const auto& value : encrypted) {
+        checksum += value.decrypt(ctx, keys);
+      }
+    });
+    double dec_session = timeMs([&] {
+      for(const auto& value : encrypted) {
+        checksum -= value.decrypt(session);
+      }
+    });
+
+    auto per_op = [&](double ms) { return ms * 1000.0 / iterations; };
+    std::printf("%-8s %14.1f %14.1f %14.1f %14.1f%s\n",
+                sealcrypt::bench::levelName(static_cast< int >(level)).c_str(),
+                per_op(enc_call),
+                per_op(enc_session),
+                per_op(dec_call),
+                per_op(dec_session),
+                checksum == 0 ? "" : "  [MISMATCH]");
+  }
+  return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace sealcrypt::bench {
+
+  /// Run fn once and return the wall time in milliseconds
+  template< class Fn >
+  auto timeMs(Fn&& fn) -> double {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration< double, std::milli >(end - start).count();
+  }
+
+  /// Read the iteration count from argv[1], or use the default
+  inline auto iterations(int argc, char* argv[], int fallback) -> int {
+    if(argc > 1) {
+      int value = std::atoi(argv[1]);
+      if(value > 0) {
+        return value;
+      }
+    }
+    return fallback;
+  }
+
+  inline auto levelName(int level) -> std::string {
+    switch(level) {
+      case 0: return "Low";
+      case 1: return "Medium";
+      default: return "High";
+    }
+  }
+
+} // namespace sealcrypt::bench
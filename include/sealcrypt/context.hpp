@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <seal/seal.h>
 #include <string>
@@ -9,6 +10,44 @@ namespace sealcrypt {
   /// Security level presets for easy configuration
   enum class SecurityLevel { Low, Medium, High };
 
+  /// Compression applied when ciphertexts and keys are serialized
+  enum class Compression { None, Zlib, Zstd };
+
+  /// When ciphertext-ciphertext products are relinearized back to two
+  /// polynomials
+  enum class RelinPolicy {
+    /// Never automatically, call relinearize() yourself
+    Manual,
+    /// Right after every multiply and square
+    Eager,
+    /// Only when a grown ciphertext is multiplied again or serialized, so
+    /// sums of products share one relinearization
+    Lazy
+  };
+
+  /// At which level ciphertexts are written out
+  enum class SavePolicy {
+    /// As they are
+    Full,
+    /// Mod switched to the lowest level that still decrypts (see
+    /// HomomorphicInt::compact()), for smaller files and faster decryption
+    Compact
+  };
+
+  /// How HomomorphicInt/HomomorphicVector power() and powers() place their
+  /// results in the modulus chain
+  struct PowerOptions {
+    /// Mod switch every power to the lowest level whose estimated noise
+    /// capacity still covers the rest of the product tree plus
+    /// reserve_depth multiplications. Lower levels mean smaller ciphertexts
+    /// and faster products, but results may then sit below other
+    /// ciphertexts; mod switch those to match before combining them.
+    bool mod_switch = false;
+
+    /// Multiplications the results must still support (with mod_switch)
+    std::size_t reserve_depth = 1;
+  };
+
   /// CryptoContext manages SEAL encryption parameters and context.
   /// This is the foundation that all other classes use.
   /// Create one context and share it across KeyPair, Encryptor, etc.
@@ -43,6 +82,85 @@ namespace sealcrypt {
     /// Get the evaluator for homomorphic operations
     [[nodiscard]] auto evaluator() const -> seal::Evaluator&;
 
+    /// Get the batch encoder for SIMD slot packing
+    /// (throws if the parameters do not support batching)
+    [[nodiscard]] auto batchEncoder() const -> const seal::BatchEncoder&;
+
+    /// Check if the plain modulus supports batching (prime, 1 mod 2n)
+    [[nodiscard]] auto supportsBatching() const -> bool;
+
+    /// Number of batching slots (equals polyModulusDegree(), 0 if no batching)
+    [[nodiscard]] auto slotCount() const -> std::size_t;
+
+    /// Encode an integer constant as a plaintext polynomial
+    /// The value is reduced mod plainModulus() (negatives wrap to t - |v|)
+    /// and written straight into the constant coefficient. Encoded constants
+    /// are kept in a small per-context LRU cache, so repeated constants
+    /// (e.g. polynomial coefficients) are only encoded once.
+    /// A constant polynomial decodes to the same value in every batching slot.
+    /// @param value The constant to encode
+    /// @return Shared, immutable plaintext
+    [[nodiscard]] auto encodeConstant(std::int64_t value) const
+        -> std::shared_ptr< const seal::Plaintext >;
+
+    /// Encode an integer constant into a caller-owned plaintext, bypassing
+    /// the cache. Suits hot loops over many distinct values, where every
+    /// lookup would miss and contend on the cache lock.
+    /// @param value The constant to encode
+    /// @param destination Plaintext to overwrite
+    void encodeConstant(std::int64_t value, seal::Plaintext& destination) const;
+
+    /// Set how many encoded constants the LRU cache keeps (0 disables it)
+    void setConstantCacheCapacity(std::size_t capacity);
+
+    /// Set the compression every save path uses: HomomorphicInt and
+    /// HomomorphicVector save()/serialize(), KeyPair save*() and the file
+    /// Encryptor. Loading reads the mode from the data, so readers do not
+    /// need a matching setting. Defaults to SEAL's default (zstd if SEAL was
+    /// built with it, otherwise zlib, otherwise none). The compression level
+    /// is fixed when SEAL is built.
+    /// @return false if this SEAL build does not support the mode
+    auto setCompression(Compression mode) -> bool;
+
+    /// Get the compression used by save paths
+    [[nodiscard]] auto compression() const -> Compression;
+
+    /// The compression as SEAL's compr_mode_type, for direct save() calls
+    [[nodiscard]] auto sealComprMode() const -> seal::compr_mode_type;
+
+    /// Check if this SEAL build supports a compression mode
+    [[nodiscard]] static auto isCompressionSupported(Compression mode) -> bool;
+
+    /// Give the context relinearization keys for the Eager and Lazy
+    /// policies. The keys are copied, the KeyPair need not outlive the
+    /// context.
+    void setRelinKeys(const seal::RelinKeys& relin_keys);
+
+    /// Check if the context holds relinearization keys
+    [[nodiscard]] auto hasRelinKeys() const -> bool;
+
+    /// Get the context's relinearization keys (throws if none were set)
+    [[nodiscard]] auto relinKeys() const -> const seal::RelinKeys&;
+
+    /// Set when HomomorphicInt and HomomorphicVector multiply and square
+    /// relinearize their results. Eager and Lazy need setRelinKeys() first.
+    /// Configure the context before sharing it across threads.
+    /// @return false if the policy needs relin keys and none are set
+    auto setRelinPolicy(RelinPolicy policy) -> bool;
+
+    /// Get the relinearization policy (default Manual)
+    [[nodiscard]] auto relinPolicy() const -> RelinPolicy;
+
+    /// Set the level HomomorphicInt and HomomorphicVector save()/
+    /// serialize() and the public-key file Encryptor write ciphertexts at.
+    /// Symmetric encryption keeps writing seeded full-level ciphertexts,
+    /// since a mod switched ciphertext loses its seed. Loading accepts any
+    /// level, so readers need no matching setting.
+    void setSavePolicy(SavePolicy policy);
+
+    /// Get the save policy (default Full)
+    [[nodiscard]] auto savePolicy() const -> SavePolicy;
+
     /// Get encryption parameters info
     [[nodiscard]] auto polyModulusDegree() const -> std::size_t;
     [[nodiscard]] auto plainModulus() const -> std::uint64_t;
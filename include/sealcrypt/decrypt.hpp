@@ -2,7 +2,9 @@
 
 #include "sealcrypt/context.hpp"
 #include "sealcrypt/keys.hpp"
+#include "sealcrypt/session.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +28,9 @@ namespace sealcrypt {
     auto operator=(Decryptor&&) noexcept -> Decryptor&;
 
     /// Decrypt a file
+    /// Ciphertexts are decrypted on threadCount() threads and written out
+    /// in order as they complete, so memory use stays constant regardless
+    /// of the file size.
     /// @param input_path Path to the encrypted file
     /// @param output_path Path for the decrypted output
     /// @param keys KeyPair with secret key available
@@ -41,6 +46,75 @@ namespace sealcrypt {
     auto decryptBytes(const std::vector< std::uint8_t >& data,
                       const KeyPair& keys) -> std::vector< std::uint8_t >;
 
+    /// Decrypt a caller-owned byte range in place, without copying it
+    /// @param data Start of the encrypted bytes
+    /// @param size Number of encrypted bytes
+    /// @param keys KeyPair with secret key available
+    /// @return Decrypted data as bytes, or empty on failure
+    auto decryptBytes(const std::byte* data,
+                      std::size_t size,
+                      const KeyPair& keys) -> std::vector< std::uint8_t >;
+
+    /// Decrypt a file with a cached session decryptor
+    /// @param input_path Path to the encrypted file
+    /// @param output_path Path for the decrypted output
+    /// @param session Session with a decryptor available
+    /// @return true if successful
+    auto decryptFile(const std::string& input_path,
+                     const std::string& output_path,
+                     const CryptoSession& session) -> bool;
+
+    /// Decrypt raw bytes with a cached session decryptor
+    /// @param data The encrypted bytes
+    /// @param session Session with a decryptor available
+    /// @return Decrypted data as bytes, or empty on failure
+    auto decryptBytes(const std::vector< std::uint8_t >& data,
+                      const CryptoSession& session)
+        -> std::vector< std::uint8_t >;
+
+    /// Decrypt a caller-owned byte range with a cached session decryptor
+    /// @param data Start of the encrypted bytes
+    /// @param size Number of encrypted bytes
+    /// @param session Session with a decryptor available
+    /// @return Decrypted data as bytes, or empty on failure
+    auto decryptBytes(const std::byte* data,
+                      std::size_t size,
+                      const CryptoSession& session)
+        -> std::vector< std::uint8_t >;
+
+    /// Decrypt a byte range of an encrypted file without reading the rest.
+    /// The chunk offset table in the file header lets the reader seek
+    /// straight to the chunks overlapping the range, so the cost grows with
+    /// the range, not the file.
+    /// @param input_path Path to the encrypted file
+    /// @param offset First plaintext byte to return
+    /// @param length Number of bytes (clipped at the end of the data)
+    /// @param keys KeyPair with secret key available
+    /// @return The decrypted bytes, or empty on failure
+    auto decryptRange(const std::string& input_path,
+                      std::uint64_t offset,
+                      std::size_t length,
+                      const KeyPair& keys) -> std::vector< std::uint8_t >;
+
+    /// Decrypt a byte range with a cached session decryptor
+    /// @param input_path Path to the encrypted file
+    /// @param offset First plaintext byte to return
+    /// @param length Number of bytes (clipped at the end of the data)
+    /// @param session Session with a decryptor available
+    /// @return The decrypted bytes, or empty on failure
+    auto decryptRange(const std::string& input_path,
+                      std::uint64_t offset,
+                      std::size_t length,
+                      const CryptoSession& session)
+        -> std::vector< std::uint8_t >;
+
+    /// Set the number of decryption threads (0 = hardware concurrency,
+    /// the default). Each thread owns its own SEAL decryptor.
+    void setThreadCount(std::size_t threads);
+
+    /// Get the resolved number of decryption threads
+    [[nodiscard]] auto threadCount() const -> std::size_t;
+
     /// Get last error message
     [[nodiscard]] auto getLastError() const -> std::string;
 
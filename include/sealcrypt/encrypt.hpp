@@ -2,6 +2,7 @@
 
 #include "sealcrypt/context.hpp"
 #include "sealcrypt/keys.hpp"
+#include "sealcrypt/session.hpp"
 
 #include <memory>
 #include <string>
@@ -9,6 +10,26 @@
 
 namespace sealcrypt {
 
+  /// How file bytes are packed into plaintext coefficients.
+  /// The packing is recorded in the file header, so Decryptor reads either.
+  enum class PackingMode {
+    /// Fill every coefficient with as many bits as the plain modulus allows
+    /// (16 bits per coefficient for the 65537 presets)
+    Dense,
+    /// One byte per coefficient, 1024 coefficients per ciphertext
+    Sparse
+  };
+
+  /// Which key file encryption uses
+  enum class EncryptionMode {
+    /// Encrypt with the public key (anyone holding it can encrypt)
+    PublicKey,
+    /// Encrypt with the secret key. Ciphertexts are stored in SEAL's seeded
+    /// form (the second polynomial is replaced by its PRNG seed), which
+    /// makes them about half the size. Decryption is unchanged.
+    Symmetric
+  };
+
   /// Encryptor handles file encryption using homomorphic encryption.
   /// Uses a shared CryptoContext for consistent parameters.
   class Encryptor {
@@ -26,9 +47,12 @@ namespace sealcrypt {
     auto operator=(Encryptor&&) noexcept -> Encryptor&;
 
     /// Encrypt a file
+    /// The input is streamed one chunk at a time, so memory use stays
+    /// constant regardless of the file size. Chunks are encrypted on
+    /// threadCount() threads and written in order.
     /// @param input_path Path to the plaintext file
     /// @param output_path Path for the encrypted output
-    /// @param keys KeyPair with public key available
+    /// @param keys KeyPair with the key for encryptionMode() available
     /// @return true if successful
     auto encryptFile(const std::string& input_path,
                      const std::string& output_path,
@@ -36,11 +60,48 @@ namespace sealcrypt {
 
     /// Encrypt raw bytes
     /// @param data The bytes to encrypt
-    /// @param keys KeyPair with public key available
+    /// @param keys KeyPair with the key for encryptionMode() available
     /// @return Encrypted data as bytes, or empty on failure
     auto encryptBytes(const std::vector< std::uint8_t >& data,
                       const KeyPair& keys) -> std::vector< std::uint8_t >;
 
+    /// Encrypt a file with a cached session encryptor
+    /// @param input_path Path to the plaintext file
+    /// @param output_path Path for the encrypted output
+    /// @param session Session with an encryptor available
+    /// @return true if successful
+    auto encryptFile(const std::string& input_path,
+                     const std::string& output_path,
+                     const CryptoSession& session) -> bool;
+
+    /// Encrypt raw bytes with a cached session encryptor
+    /// @param data The bytes to encrypt
+    /// @param session Session with an encryptor available
+    /// @return Encrypted data as bytes, or empty on failure
+    auto encryptBytes(const std::vector< std::uint8_t >& data,
+                      const CryptoSession& session)
+        -> std::vector< std::uint8_t >;
+
+    /// Set the packing used by subsequent encryptions (default Dense)
+    void setPackingMode(PackingMode mode);
+
+    /// Get the current packing mode
+    [[nodiscard]] auto packingMode() const -> PackingMode;
+
+    /// Set which key subsequent encryptions use (default PublicKey).
+    /// Symmetric mode needs the secret key in the KeyPair or session.
+    void setEncryptionMode(EncryptionMode mode);
+
+    /// Get the current encryption mode
+    [[nodiscard]] auto encryptionMode() const -> EncryptionMode;
+
+    /// Set the number of encryption threads (0 = hardware concurrency,
+    /// the default). Each thread owns its own SEAL encryptor.
+    void setThreadCount(std::size_t threads);
+
+    /// Get the resolved number of encryption threads
+    [[nodiscard]] auto threadCount() const -> std::size_t;
+
     /// Get last error message
     [[nodiscard]] auto getLastError() const -> std::string;
 
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "sealcrypt/context.hpp"
+#include "sealcrypt/homomorphic.hpp"
+#include "sealcrypt/keys.hpp"
+#include "sealcrypt/session.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sealcrypt {
+
+  namespace detail {
+    struct ExpressionNode;
+  } // namespace detail
+
+  /// Expression records HomomorphicInt arithmetic as a DAG instead of
+  /// running it, and evaluates the whole DAG at once when it is decrypted,
+  /// serialized or evaluate()d. Seeing the whole formula lets the evaluator:
+  ///  - merge common subexpressions (a*b + a*b multiplies once)
+  ///  - work in place on temporaries that have no other use, instead of
+  ///    allocating a new ciphertext for every intermediate result
+  ///  - relinearize a product only when it is multiplied again or returned,
+  ///    so a sum of products shares one relinearization (needs
+  ///    CryptoContext::setRelinKeys(), otherwise products are left as is)
+  ///
+  /// Example usage:
+  /// @code
+  ///   auto score = lazy(a) * lazy(b) + lazy(c) * lazy(d) - lazy(e);
+  ///   auto result = score.evaluate(ctx);  // or score.decrypt(ctx, keys)
+  /// @endcode
+  ///
+  /// Leaves built from an lvalue HomomorphicInt refer to it, so it must
+  /// outlive the expression. Leaves built from an rvalue take ownership.
+  /// Expressions are immutable and cheap to copy (nodes are shared).
+  class Expression {
+  public:
+    /// Leaf referring to an encrypted value (must outlive the expression)
+    explicit Expression(const HomomorphicInt& value);
+
+    /// Leaf owning an encrypted value
+    explicit Expression(HomomorphicInt&& value);
+
+    // Moving copies the shared node, so a moved-from expression still
+    // evaluates
+    Expression(const Expression& other) = default;
+    auto operator=(const Expression& other) -> Expression& = default;
+    Expression(Expression&& other) noexcept;
+    auto operator=(Expression&& other) noexcept -> Expression&;
+    ~Expression() = default;
+
+    // ==================== Building ====================
+
+    friend auto operator+(const Expression& lhs, const Expression& rhs)
+        -> Expression;
+    friend auto operator-(const Expression& lhs, const Expression& rhs)
+        -> Expression;
+    friend auto operator*(const Expression& lhs, const Expression& rhs)
+        -> Expression;
+    friend auto operator-(const Expression& operand) -> Expression;
+
+    /// Plaintext constants, applied with SEAL's plain operations
+    friend auto operator+(const Expression& lhs, std::int64_t rhs)
+        -> Expression;
+    friend auto operator-(const Expression& lhs, std::int64_t rhs)
+        -> Expression;
+    friend auto operator*(const Expression& lhs, std::int64_t rhs)
+        -> Expression;
+    friend auto operator+(std::int64_t lhs, const Expression& rhs)
+        -> Expression;
+    friend auto operator-(std::int64_t lhs, const Expression& rhs)
+        -> Expression;
+    friend auto operator*(std::int64_t lhs, const Expression& rhs)
+        -> Expression;
+
+    // ==================== Evaluation ====================
+    // Every call evaluates the DAG again, keep the HomomorphicInt from
+    // evaluate() to reuse a result.
+
+    /// Evaluate the expression
+    /// @return The result, or an invalid HomomorphicInt if a leaf is invalid
+    ///         or a constant factor is a multiple of plainModulus()
+    [[nodiscard]] auto evaluate(const CryptoContext& ctx) const
+        -> HomomorphicInt;
+
+    /// Evaluate and decrypt
+    [[nodiscard]] auto decrypt(const CryptoContext& ctx,
+                               const KeyPair& keys) const -> std::int64_t;
+
+    /// Evaluate and decrypt with a cached session decryptor
+    [[nodiscard]] auto decrypt(const CryptoSession& session) const
+        -> std::int64_t;
+
+    /// Evaluate and serialize
+    [[nodiscard]] auto serialize(const CryptoContext& ctx) const
+        -> std::vector< std::uint8_t >;
+
+    /// Number of homomorphic operations evaluate() runs once common
+    /// subexpressions are merged (leaves excluded)
+    [[nodiscard]] auto operationCount() const -> std::size_t;
+
+  private:
+    std::shared_ptr< const detail::ExpressionNode > node_;
+
+    explicit Expression(std::shared_ptr< const detail::ExpressionNode > node);
+  };
+
+  /// Start an expression from an encrypted value, which must outlive it
+  inline auto lazy(const HomomorphicInt& value) -> Expression {
+    return Expression(value);
+  }
+
+  /// Start an expression from a temporary, the expression takes ownership
+  inline auto lazy(HomomorphicInt&& value) -> Expression {
+    return Expression(std::move(value));
+  }
+
+} // namespace sealcrypt
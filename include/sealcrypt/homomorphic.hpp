@@ -2,7 +2,9 @@
 
 #include "sealcrypt/context.hpp"
 #include "sealcrypt/keys.hpp"
+#include "sealcrypt/session.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <seal/seal.h>
 #include <string>
@@ -31,9 +33,12 @@ namespace sealcrypt {
     HomomorphicInt();
     ~HomomorphicInt();
 
-    // Copy only (no move)
+    // Copy makes a deep copy of the ciphertext, move steals it.
+    // A moved-from HomomorphicInt is empty (isValid() == false).
     HomomorphicInt(const HomomorphicInt& other);
     auto operator=(const HomomorphicInt& other) -> HomomorphicInt&;
+    HomomorphicInt(HomomorphicInt&& other) noexcept;
+    auto operator=(HomomorphicInt&& other) noexcept -> HomomorphicInt&;
 
     // ==================== Encryption / Decryption ====================
 
@@ -46,27 +51,143 @@ namespace sealcrypt {
                         const CryptoContext& ctx,
                         const KeyPair& keys) -> HomomorphicInt;
 
-    /// Decrypt to get the original integer
+    /// Decrypt to get the original integer. Values live modulo
+    /// plainModulus() t and come back in [0, t), so a negative v decrypts
+    /// as t - |v|; use decryptSigned() for the signed value.
     /// @param ctx The crypto context
     /// @param keys KeyPair with secret key available
-    /// @return The decrypted integer value
+    /// @return The decrypted integer value in [0, t)
     [[nodiscard]] auto decrypt(const CryptoContext& ctx,
                                const KeyPair& keys) const -> std::int64_t;
 
+    /// Decrypt to a signed value in [-(t-1)/2, (t-1)/2], the range
+    /// HomomorphicVector decrypts to, so encrypt(-5) decrypts to -5
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with secret key available
+    /// @return The decrypted integer value
+    [[nodiscard]] auto decryptSigned(const CryptoContext& ctx,
+                                     const KeyPair& keys) const
+        -> std::int64_t;
+
+    /// Encrypt an integer value with a cached session encryptor
+    /// @param value The integer to encrypt
+    /// @param session Session with an encryptor available
+    /// @return Encrypted HomomorphicInt
+    static auto encrypt(std::int64_t value, const CryptoSession& session)
+        -> HomomorphicInt;
+
+    /// Decrypt with a cached session decryptor
+    /// @param session Session with a decryptor available
+    /// @return The decrypted integer value in [0, t)
+    [[nodiscard]] auto decrypt(const CryptoSession& session) const
+        -> std::int64_t;
+
+    /// Decrypt to a signed value with a cached session decryptor, see
+    /// decryptSigned(ctx, keys)
+    /// @param session Session with a decryptor available
+    /// @return The decrypted integer value
+    [[nodiscard]] auto decryptSigned(const CryptoSession& session) const
+        -> std::int64_t;
+
+    /// Encrypt count values into the preallocated out[0..count) on a pool
+    /// of threads, each with its own SEAL encryptor and memory pool.
+    /// Elements that fail to encrypt are left invalid with getLastError()
+    /// set, like encrypt().
+    /// @param values The integers to encrypt
+    /// @param count Number of values
+    /// @param out Destination array of at least count elements
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with public key available
+    /// @param threads Worker threads, 0 for one per hardware thread
+    /// @return true if every value was encrypted
+    static auto encryptMany(const std::int64_t* values,
+                            std::size_t count,
+                            HomomorphicInt* out,
+                            const CryptoContext& ctx,
+                            const KeyPair& keys,
+                            std::size_t threads = 0) -> bool;
+
+    /// Encrypt a vector of values, see the array overload
+    /// @return One HomomorphicInt per value
+    static auto encryptMany(const std::vector< std::int64_t >& values,
+                            const CryptoContext& ctx,
+                            const KeyPair& keys,
+                            std::size_t threads = 0)
+        -> std::vector< HomomorphicInt >;
+
+    /// Decrypt count ciphertexts into the preallocated out[0..count) on a
+    /// pool of threads, each with its own SEAL decryptor. Invalid inputs
+    /// decrypt to 0, like decrypt(); a SEAL failure throws.
+    /// @param values The ciphertexts to decrypt
+    /// @param count Number of ciphertexts
+    /// @param out Destination array of at least count elements
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with secret key available
+    /// @param threads Worker threads, 0 for one per hardware thread
+    static void decryptMany(const HomomorphicInt* values,
+                            std::size_t count,
+                            std::int64_t* out,
+                            const CryptoContext& ctx,
+                            const KeyPair& keys,
+                            std::size_t threads = 0);
+
+    /// Decrypt a vector of ciphertexts, see the array overload
+    /// @return One integer per ciphertext
+    static auto decryptMany(const std::vector< HomomorphicInt >& values,
+                            const CryptoContext& ctx,
+                            const KeyPair& keys,
+                            std::size_t threads = 0)
+        -> std::vector< std::int64_t >;
+
+    /// Encrypt with the secret key and serialize in SEAL's seeded form.
+    /// The second ciphertext polynomial is replaced by the seed that
+    /// generated it, so the bytes are about half the size of serialize().
+    /// Load them with deserialize() or load(), SEAL expands the seed.
+    /// @param value The integer to encrypt
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with secret key available
+    /// @return Seeded ciphertext bytes, or empty on failure
+    static auto encryptSymmetric(std::int64_t value,
+                                 const CryptoContext& ctx,
+                                 const KeyPair& keys)
+        -> std::vector< std::uint8_t >;
+
+    /// Symmetric seeded encryption with a cached session encryptor
+    /// @param value The integer to encrypt
+    /// @param session Session with a symmetric encryptor available
+    /// @return Seeded ciphertext bytes, or empty on failure
+    static auto encryptSymmetric(std::int64_t value,
+                                 const CryptoSession& session)
+        -> std::vector< std::uint8_t >;
+
     // ==================== Arithmetic Operators (Ciphertext + Ciphertext)
     // ====================
+    // Overloads taking an rvalue operand reuse its ciphertext storage and
+    // run the in-place SEAL operation, so `std::move(a) + b` and chains like
+    // `a + b + c` allocate a single result ciphertext.
 
     /// Homomorphic addition
-    auto operator+(const HomomorphicInt& other) const -> HomomorphicInt;
+    auto operator+(const HomomorphicInt& other) const& -> HomomorphicInt;
+    auto operator+(const HomomorphicInt& other) && -> HomomorphicInt;
+    auto operator+(HomomorphicInt&& other) const& -> HomomorphicInt;
+    auto operator+(HomomorphicInt&& other) && -> HomomorphicInt;
 
     /// Homomorphic subtraction
-    auto operator-(const HomomorphicInt& other) const -> HomomorphicInt;
-
-    /// Homomorphic multiplication
-    auto operator*(const HomomorphicInt& other) const -> HomomorphicInt;
+    auto operator-(const HomomorphicInt& other) const& -> HomomorphicInt;
+    auto operator-(const HomomorphicInt& other) && -> HomomorphicInt;
+    auto operator-(HomomorphicInt&& other) const& -> HomomorphicInt;
+    auto operator-(HomomorphicInt&& other) && -> HomomorphicInt;
+
+    /// Homomorphic multiplication. The context's relinPolicy() decides
+    /// whether the product is relinearized (see CryptoContext).
+    auto operator*(const HomomorphicInt& other) const& -> HomomorphicInt;
+    auto operator*(const HomomorphicInt& other) && -> HomomorphicInt;
+    auto operator*(HomomorphicInt&& other) const& -> HomomorphicInt;
+    auto operator*(HomomorphicInt&& other) && -> HomomorphicInt;
 
     /// Homomorphic negation
-    auto operator-() const -> HomomorphicInt;
+    auto operator-() const& -> HomomorphicInt;
+    auto operator-() && -> HomomorphicInt;
 
     /// In-place addition
     auto operator+=(const HomomorphicInt& other) -> HomomorphicInt&;
@@ -78,42 +199,95 @@ namespace sealcrypt {
     auto operator*=(const HomomorphicInt& other) -> HomomorphicInt&;
 
     // ==================== Arithmetic with Plaintexts ====================
-    // More efficient than encrypting the plaintext first
+    // More efficient than encrypting the plaintext first.
+    // The && overloads work in place on a temporary (e.g. x.square(ctx)
+    // .mulPlain(3, ctx) allocates one ciphertext, not two).
 
     /// Add a plaintext value
-    auto addPlain(std::int64_t value, const CryptoContext& ctx) const
+    auto addPlain(std::int64_t value, const CryptoContext& ctx) const&
+        -> HomomorphicInt;
+    auto addPlain(std::int64_t value, const CryptoContext& ctx) &&
         -> HomomorphicInt;
 
     /// Subtract a plaintext value
-    auto subPlain(std::int64_t value, const CryptoContext& ctx) const
+    auto subPlain(std::int64_t value, const CryptoContext& ctx) const&
+        -> HomomorphicInt;
+    auto subPlain(std::int64_t value, const CryptoContext& ctx) &&
         -> HomomorphicInt;
 
     /// Multiply by a plaintext value
-    auto mulPlain(std::int64_t value, const CryptoContext& ctx) const
+    /// @return The product, or an invalid value with getLastError() set if
+    ///         value is a multiple of plainModulus() (SEAL rejects the
+    ///         transparent result)
+    auto mulPlain(std::int64_t value, const CryptoContext& ctx) const&
+        -> HomomorphicInt;
+    auto mulPlain(std::int64_t value, const CryptoContext& ctx) &&
         -> HomomorphicInt;
 
     // ==================== Advanced Operations ====================
 
     /// Square the encrypted value (more efficient than a * a)
-    auto square(const CryptoContext& ctx) const -> HomomorphicInt;
+    auto square(const CryptoContext& ctx) const& -> HomomorphicInt;
+    auto square(const CryptoContext& ctx) && -> HomomorphicInt;
 
-    /// Raise to a power (exponentiation)
+    /// Raise to a power with a balanced product tree: x^e is
+    /// x^(2^a) * x^(e - 2^a), so it costs powerDepth(e) = ceil(log2(e))
+    /// levels of multiplication, each product relinearized
     /// @param exponent The power to raise to (must be positive)
     /// @param ctx The crypto context
     /// @param keys KeyPair with relinearization keys
+    /// @param options Optional level management (see PowerOptions)
+    /// @return The power, or an invalid value with getLastError() set
     auto power(std::uint64_t exponent,
                const CryptoContext& ctx,
-               const KeyPair& keys) const -> HomomorphicInt;
+               const KeyPair& keys,
+               const PowerOptions& options = {}) const& -> HomomorphicInt;
+    auto power(std::uint64_t exponent,
+               const CryptoContext& ctx,
+               const KeyPair& keys,
+               const PowerOptions& options = {}) && -> HomomorphicInt;
 
-    /// Relinearize after multiplication to reduce ciphertext size
+    /// All powers x^1 .. x^count from one product tree, every intermediate
+    /// power computed once. x^e sits at depth powerDepth(e).
+    /// @param count Highest power (must be positive)
     /// @param ctx The crypto context
     /// @param keys KeyPair with relinearization keys
-    auto relinearize(const CryptoContext& ctx, const KeyPair& keys) const
+    /// @param options Optional level management (see PowerOptions)
+    /// @return count values, or empty with getLastError() set on this
+    [[nodiscard]] auto powers(std::uint64_t count,
+                              const CryptoContext& ctx,
+                              const KeyPair& keys,
+                              const PowerOptions& options = {}) const
+        -> std::vector< HomomorphicInt >;
+
+    /// Multiplicative depth power(exponent) consumes: ceil(log2(exponent))
+    static auto powerDepth(std::uint64_t exponent) -> std::size_t;
+
+    /// Relinearize after multiplication to reduce ciphertext size. Only
+    /// needed under RelinPolicy::Manual, the default.
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with relinearization keys
+    auto relinearize(const CryptoContext& ctx, const KeyPair& keys) const&
+        -> HomomorphicInt;
+    auto relinearize(const CryptoContext& ctx, const KeyPair& keys) &&
         -> HomomorphicInt;
 
     /// Mod switch to next level (reduces noise budget consumption)
     /// @param ctx The crypto context
-    auto modSwitchToNext(const CryptoContext& ctx) const -> HomomorphicInt;
+    auto modSwitchToNext(const CryptoContext& ctx) const& -> HomomorphicInt;
+    auto modSwitchToNext(const CryptoContext& ctx) && -> HomomorphicInt;
+
+    /// Mod switch down to the lowest level that, by a conservative noise
+    /// estimate that needs no secret key, still leaves room for
+    /// reserve_depth multiplications and a correct decryption. Smaller to
+    /// store and send, faster to decrypt. Other ciphertexts must be
+    /// switched to the same level before they are combined with the result.
+    /// @param ctx The crypto context
+    /// @param reserve_depth Multiplications the result must still support
+    auto compact(const CryptoContext& ctx,
+                 std::size_t reserve_depth = 0) const& -> HomomorphicInt;
+    auto compact(const CryptoContext& ctx, std::size_t reserve_depth = 0) &&
+        -> HomomorphicInt;
 
     // ==================== Utility / Info ====================
 
@@ -128,6 +302,27 @@ namespace sealcrypt {
     [[nodiscard]] auto noiseBudget(const CryptoContext& ctx,
                                    const KeyPair& keys) const -> int;
 
+    /// Get the noise budget remaining (bits) using a cached session decryptor
+    /// @param session Session with a decryptor available
+    /// @return Noise budget in bits, or 0 on error
+    [[nodiscard]] auto noiseBudget(const CryptoSession& session) const -> int;
+
+    /// Heuristic noise budget (bits) tracked through every operator, no
+    /// secret key or decryption needed. Errs low: each multiplication is
+    /// charged about log2(t * n) bits, each addition one bit. A loaded or
+    /// wrapped ciphertext is assumed fresh at its level. Use noiseBudget()
+    /// where the secret key is at hand and the exact figure matters.
+    /// @return Estimated budget in bits, 0 if invalid or exhausted
+    [[nodiscard]] auto estimatedNoiseBudget() const -> int;
+
+    /// Multiplicative depth consumed: ciphertext-ciphertext multiplications
+    /// on the longest path from a fresh encryption (or a load)
+    [[nodiscard]] auto depth() const -> std::size_t;
+
+    /// Current level: the chain index of the ciphertext's modulus, lower
+    /// after each mod switch. 0 if invalid or on the last level.
+    [[nodiscard]] auto level() const -> std::size_t;
+
     /// Get ciphertext size (number of polynomials)
     /// Size increases after multiplication, relinearization reduces it
     [[nodiscard]] auto size() const -> std::size_t;
@@ -139,6 +334,11 @@ namespace sealcrypt {
     /// Get last error message
     [[nodiscard]] auto getLastError() const -> std::string;
 
+    /// Number of ciphertext buffers HomomorphicInt has materialised since
+    /// program start: fresh encryptions, out-of-place results and deep
+    /// copies. In-place and move paths do not count. Diagnostic only.
+    [[nodiscard]] static auto ciphertextAllocations() -> std::uint64_t;
+
     // ==================== Serialization ====================
 
     /// Save encrypted value to file
@@ -155,6 +355,26 @@ namespace sealcrypt {
     auto deserialize(const std::vector< std::uint8_t >& data,
                      const CryptoContext& ctx) -> bool;
 
+    /// Upper bound on the bytes serializeTo() writes under the context's
+    /// compression, for sizing the caller's buffer
+    [[nodiscard]] auto saveSize(const CryptoContext& ctx) const -> std::size_t;
+
+    /// Serialize straight into a caller-provided buffer, no intermediate
+    /// copies. std::byte is SEAL's seal_byte.
+    /// @param out Destination buffer, saveSize(ctx) bytes is always enough
+    /// @param size Size of the destination buffer
+    /// @return Bytes written, or 0 on failure (e.g. buffer too small)
+    auto serializeTo(std::byte* out,
+                     std::size_t size,
+                     const CryptoContext& ctx) const -> std::size_t;
+
+    /// Deserialize from a caller-owned byte range without copying it
+    /// @param data Start of the serialized ciphertext
+    /// @param size Number of bytes available at data
+    auto deserialize(const std::byte* data,
+                     std::size_t size,
+                     const CryptoContext& ctx) -> bool;
+
     // ==================== Advanced Access ====================
 
     /// Get the underlying ciphertext (for advanced users)
@@ -163,6 +383,21 @@ namespace sealcrypt {
     /// Get mutable ciphertext (for advanced users)
     [[nodiscard]] auto ciphertextMut() -> seal::Ciphertext&;
 
+    /// Wrap an existing SEAL ciphertext (for advanced users)
+    /// @param ciphertext Ciphertext valid for ctx
+    /// @param ctx The crypto context (must outlive the result)
+    static auto fromCiphertext(seal::Ciphertext ciphertext,
+                               const CryptoContext& ctx) -> HomomorphicInt;
+
+    /// Wrap an existing SEAL ciphertext with a known history
+    /// @param depth Multiplicative depth the ciphertext has consumed
+    /// @param noise_budget Estimated noise budget in bits (see
+    ///        estimatedNoiseBudget())
+    static auto fromCiphertext(seal::Ciphertext ciphertext,
+                               const CryptoContext& ctx,
+                               std::size_t depth,
+                               int noise_budget) -> HomomorphicInt;
+
     /// Set the context for operations
     void setContext(const CryptoContext* ctx);
 
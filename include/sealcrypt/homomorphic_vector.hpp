@@ -0,0 +1,309 @@
+#pragma once
+
+#include "sealcrypt/context.hpp"
+#include "sealcrypt/keys.hpp"
+#include "sealcrypt/session.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <seal/seal.h>
+#include <string>
+#include <vector>
+
+namespace sealcrypt {
+
+  /// HomomorphicVector packs up to ctx.slotCount() integers into the
+  /// batching slots of a single ciphertext. Every operation acts on all
+  /// slots at once (element-wise), so one ciphertext operation does the
+  /// work of thousands of HomomorphicInt operations.
+  ///
+  /// Slot values live modulo plainModulus() and decrypt as signed values in
+  /// the range [-(t-1)/2, (t-1)/2].
+  ///
+  /// Example usage:
+  /// @code
+  ///   CryptoContext ctx;
+  ///   KeyPair keys(ctx);
+  ///   keys.generate();
+  ///
+  ///   auto a = HomomorphicVector::encrypt({1, 2, 3}, ctx, keys);
+  ///   auto b = HomomorphicVector::encrypt({10, 20, 30}, ctx, keys);
+  ///   auto sum = a + b;
+  ///   auto values = sum.decrypt(ctx, keys);  // {11, 22, 33, 0, 0, ...}
+  /// @endcode
+  class HomomorphicVector {
+  public:
+    // ==================== Constructors / Destructor ====================
+
+    /// Create an empty HomomorphicVector
+    HomomorphicVector();
+    ~HomomorphicVector();
+
+    // Copy makes a deep copy of the ciphertext, move steals it.
+    // A moved-from HomomorphicVector is empty (isValid() == false).
+    HomomorphicVector(const HomomorphicVector& other);
+    auto operator=(const HomomorphicVector& other) -> HomomorphicVector&;
+    HomomorphicVector(HomomorphicVector&& other) noexcept;
+    auto operator=(HomomorphicVector&& other) noexcept -> HomomorphicVector&;
+
+    // ==================== Encryption / Decryption ====================
+
+    /// Encrypt a vector of integers into the batching slots
+    /// @param values Up to ctx.slotCount() values, remaining slots are zero
+    /// @param ctx The crypto context (must support batching)
+    /// @param keys KeyPair with public key available
+    /// @return Encrypted HomomorphicVector (invalid on failure)
+    static auto encrypt(const std::vector< std::int64_t >& values,
+                        const CryptoContext& ctx,
+                        const KeyPair& keys) -> HomomorphicVector;
+
+    /// Decrypt all slots
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with secret key available
+    /// @return ctx.slotCount() decrypted values
+    [[nodiscard]] auto decrypt(const CryptoContext& ctx,
+                               const KeyPair& keys) const
+        -> std::vector< std::int64_t >;
+
+    /// Encrypt a vector of integers with a cached session encryptor
+    /// @param values Up to ctx.slotCount() values, remaining slots are zero
+    /// @param session Session with an encryptor available
+    static auto encrypt(const std::vector< std::int64_t >& values,
+                        const CryptoSession& session) -> HomomorphicVector;
+
+    /// Decrypt all slots with a cached session decryptor
+    /// @param session Session with a decryptor available
+    [[nodiscard]] auto decrypt(const CryptoSession& session) const
+        -> std::vector< std::int64_t >;
+
+    // ==================== Arithmetic Operators (element-wise) ============
+
+    /// Homomorphic slot-wise addition
+    auto operator+(const HomomorphicVector& other) const -> HomomorphicVector;
+
+    /// Homomorphic slot-wise subtraction
+    auto operator-(const HomomorphicVector& other) const -> HomomorphicVector;
+
+    /// Homomorphic slot-wise multiplication
+    auto operator*(const HomomorphicVector& other) const -> HomomorphicVector;
+
+    /// Homomorphic slot-wise negation
+    auto operator-() const -> HomomorphicVector;
+
+    /// In-place addition
+    auto operator+=(const HomomorphicVector& other) -> HomomorphicVector&;
+
+    /// In-place subtraction
+    auto operator-=(const HomomorphicVector& other) -> HomomorphicVector&;
+
+    /// In-place multiplication
+    auto operator*=(const HomomorphicVector& other) -> HomomorphicVector&;
+
+    // ==================== Arithmetic with Plaintexts ====================
+    // Scalar overloads apply the same value to every slot
+
+    /// Add a plaintext scalar to every slot
+    auto addPlain(std::int64_t value, const CryptoContext& ctx) const
+        -> HomomorphicVector;
+
+    /// Add a plaintext vector slot-wise
+    auto addPlain(const std::vector< std::int64_t >& values,
+                  const CryptoContext& ctx) const -> HomomorphicVector;
+
+    /// Subtract a plaintext scalar from every slot
+    auto subPlain(std::int64_t value, const CryptoContext& ctx) const
+        -> HomomorphicVector;
+
+    /// Subtract a plaintext vector slot-wise
+    auto subPlain(const std::vector< std::int64_t >& values,
+                  const CryptoContext& ctx) const -> HomomorphicVector;
+
+    /// Multiply every slot by a plaintext scalar
+    auto mulPlain(std::int64_t value, const CryptoContext& ctx) const
+        -> HomomorphicVector;
+
+    /// Multiply by a plaintext vector slot-wise
+    auto mulPlain(const std::vector< std::int64_t >& values,
+                  const CryptoContext& ctx) const -> HomomorphicVector;
+
+    // ==================== Advanced Operations ====================
+
+    /// Square every slot (more efficient than v * v)
+    auto square(const CryptoContext& ctx) const -> HomomorphicVector;
+
+    /// Raise every slot to a power with a balanced product tree, see
+    /// HomomorphicInt::power()
+    /// @param exponent The power to raise to (must be positive)
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with relinearization keys
+    /// @param options Optional level management (see PowerOptions)
+    /// @return The power, or an invalid value with getLastError() set
+    auto power(std::uint64_t exponent,
+               const CryptoContext& ctx,
+               const KeyPair& keys,
+               const PowerOptions& options = {}) const -> HomomorphicVector;
+
+    /// All powers v^1 .. v^count from one product tree, see
+    /// HomomorphicInt::powers()
+    /// @return count vectors, or empty with getLastError() set on this
+    [[nodiscard]] auto powers(std::uint64_t count,
+                              const CryptoContext& ctx,
+                              const KeyPair& keys,
+                              const PowerOptions& options = {}) const
+        -> std::vector< HomomorphicVector >;
+
+    /// Relinearize after multiplication to reduce ciphertext size
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with relinearization keys
+    auto relinearize(const CryptoContext& ctx, const KeyPair& keys) const
+        -> HomomorphicVector;
+
+    /// Mod switch to next level
+    /// @param ctx The crypto context
+    auto modSwitchToNext(const CryptoContext& ctx) const -> HomomorphicVector;
+
+    /// Mod switch down to the lowest level that still decrypts, see
+    /// HomomorphicInt::compact()
+    /// @param ctx The crypto context
+    /// @param reserve_depth Multiplications the result must still support
+    auto compact(const CryptoContext& ctx, std::size_t reserve_depth = 0) const
+        -> HomomorphicVector;
+
+    // ==================== Rotations ====================
+    // Batching arranges the slots as 2 rows of slotCount() / 2. Rotations
+    // need Galois keys (KeyPair::generateGaloisKeys()); a product that is
+    // not yet relinearized is relinearized first, which needs relin keys.
+    // On failure the result is invalid and getLastError() is set on this.
+
+    /// Rotate both rows cyclically: slot i of each row receives slot
+    /// i + steps of the same row. Negative steps rotate the other way.
+    /// @param steps Slots to rotate by, |steps| < slotCount() / 2
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with Galois keys
+    auto rotateRows(int steps,
+                    const CryptoContext& ctx,
+                    const KeyPair& keys) const -> HomomorphicVector;
+
+    /// Swap the two rows
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with Galois keys
+    auto rotateColumns(const CryptoContext& ctx, const KeyPair& keys) const
+        -> HomomorphicVector;
+
+    /// Sum of all slots, in every slot. Rotate-and-add doubling: log2 of the
+    /// row size row rotations and one column rotation, no multiplications.
+    /// With count set, only the first count slots of the first row are
+    /// summed, into slot 0, in ceil(log2(count)) rotations; slots from
+    /// count up to the next power of two must be zero, as encrypt() leaves
+    /// them. innerSumSteps() lists the Galois keys either form needs.
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with Galois keys
+    /// @param count Slots to sum, 0 (or more than a row) for all
+    auto innerSum(const CryptoContext& ctx,
+                  const KeyPair& keys,
+                  std::size_t count = 0) const -> HomomorphicVector;
+
+    /// Dot product with another vector: the slot-wise product, relinearized
+    /// and inner-summed. Every slot of the result holds the dot product.
+    /// @param other Vector of the same context
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with relin and Galois keys
+    auto dot(const HomomorphicVector& other,
+             const CryptoContext& ctx,
+             const KeyPair& keys) const -> HomomorphicVector;
+
+    /// Dot product with plaintext weights, no ciphertext multiplication
+    /// @param weights Up to ctx.slotCount() weights, missing ones are zero
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with Galois keys
+    auto dotPlain(const std::vector< std::int64_t >& weights,
+                  const CryptoContext& ctx,
+                  const KeyPair& keys) const -> HomomorphicVector;
+
+    // ==================== Utility / Info ====================
+
+    /// Check if this contains valid encrypted data
+    [[nodiscard]] auto isValid() const -> bool;
+
+    /// Get the noise budget remaining (bits)
+    /// @param ctx The crypto context
+    /// @param keys KeyPair with secret key
+    /// @return Noise budget in bits, or 0 on error
+    [[nodiscard]] auto noiseBudget(const CryptoContext& ctx,
+                                   const KeyPair& keys) const -> int;
+
+    /// Get the noise budget remaining (bits) using a cached session decryptor
+    [[nodiscard]] auto noiseBudget(const CryptoSession& session) const -> int;
+
+    /// Get ciphertext size (number of polynomials)
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    /// Check if ciphertext is transparent (trivially decryptable - security
+    /// risk)
+    [[nodiscard]] auto isTransparent() const -> bool;
+
+    /// Get last error message
+    [[nodiscard]] auto getLastError() const -> std::string;
+
+    // ==================== Serialization ====================
+
+    /// Save encrypted vector to file
+    auto save(const std::string& path, const CryptoContext& ctx) const -> bool;
+
+    /// Load encrypted vector from file
+    auto load(const std::string& path, const CryptoContext& ctx) -> bool;
+
+    /// Serialize to byte vector
+    [[nodiscard]] auto serialize(const CryptoContext& ctx) const
+        -> std::vector< std::uint8_t >;
+
+    /// Deserialize from byte vector
+    auto deserialize(const std::vector< std::uint8_t >& data,
+                     const CryptoContext& ctx) -> bool;
+
+    /// Upper bound on the bytes serializeTo() writes under the context's
+    /// compression, for sizing the caller's buffer
+    [[nodiscard]] auto saveSize(const CryptoContext& ctx) const -> std::size_t;
+
+    /// Serialize straight into a caller-provided buffer, no intermediate
+    /// copies. std::byte is SEAL's seal_byte.
+    /// @param out Destination buffer, saveSize(ctx) bytes is always enough
+    /// @param size Size of the destination buffer
+    /// @return Bytes written, or 0 on failure (e.g. buffer too small)
+    auto serializeTo(std::byte* out,
+                     std::size_t size,
+                     const CryptoContext& ctx) const -> std::size_t;
+
+    /// Deserialize from a caller-owned byte range without copying it
+    /// @param data Start of the serialized ciphertext
+    /// @param size Number of bytes available at data
+    auto deserialize(const std::byte* data,
+                     std::size_t size,
+                     const CryptoContext& ctx) -> bool;
+
+    // ==================== Advanced Access ====================
+
+    /// Get the underlying ciphertext (for advanced users)
+    [[nodiscard]] auto ciphertext() const -> const seal::Ciphertext&;
+
+    /// Get mutable ciphertext (for advanced users)
+    [[nodiscard]] auto ciphertextMut() -> seal::Ciphertext&;
+
+    /// Wrap an existing SEAL ciphertext (for advanced users)
+    /// @param ciphertext Batched ciphertext valid for ctx
+    /// @param ctx The crypto context (must outlive the result)
+    static auto fromCiphertext(seal::Ciphertext ciphertext,
+                               const CryptoContext& ctx) -> HomomorphicVector;
+
+    /// Set the context for operations
+    void setContext(const CryptoContext* ctx);
+
+  private:
+    struct Impl;
+    std::unique_ptr< Impl > impl_;
+
+    // Private constructor for internal use
+    explicit HomomorphicVector(seal::Ciphertext ct, const CryptoContext* ctx);
+  };
+
+} // namespace sealcrypt
@@ -5,6 +5,7 @@
 #include <memory>
 #include <seal/seal.h>
 #include <string>
+#include <vector>
 
 namespace sealcrypt {
 
@@ -31,19 +32,48 @@ namespace sealcrypt {
     auto generate() -> bool;
 
     /// Generate relinearization keys (needed for multiplication)
-    /// Must call generate() first
+    /// Needs a secret key, from generate() or loaded
     /// @return true if successful
     auto generateRelinKeys() -> bool;
 
     /// Generate Galois keys (needed for rotation operations)
-    /// Must call generate() first
+    /// Needs a secret key, from generate() or loaded
     /// @return true if successful
     auto generateGaloisKeys() -> bool;
 
+    /// Generate Galois keys for the given rotation steps only. The default
+    /// set covers every power-of-two step both ways, hundreds of MB at
+    /// degree 16384; see rotation_plan.hpp for what common layouts need.
+    /// Needs a secret key, from generate() or loaded
+    /// @param steps Row rotation steps, 0 for rotateColumns()
+    /// @return true if successful
+    auto generateGaloisKeys(const std::vector< int >& steps) -> bool;
+
     /// Generate all keys at once (public, secret, relin, galois)
     /// @return true if successful
     auto generateAll() -> bool;
 
+    /// Generate relin and the default Galois keys in one parallel pass.
+    /// With a loaded secret key this rebuilds the evaluation keys locally:
+    /// for an evaluator trusted with the secret key, regenerating them is
+    /// faster than reading gigabytes of them from disk.
+    /// Needs a secret key, from generate() or loaded
+    /// @return true if successful
+    auto generateEvaluationKeys() -> bool;
+
+    /// Same, with Galois keys for the given rotation steps only
+    /// @param steps Row rotation steps, 0 for rotateColumns()
+    auto generateEvaluationKeys(const std::vector< int >& steps) -> bool;
+
+    /// Set the number of threads generateAll(), generateEvaluationKeys()
+    /// and generateGaloisKeys() spread key-switching keys over (0 =
+    /// hardware concurrency, the default). Each thread owns its own SEAL
+    /// key generator.
+    void setThreadCount(std::size_t threads);
+
+    /// Get the resolved number of key generation threads
+    [[nodiscard]] auto threadCount() const -> std::size_t;
+
     // ==================== Save Keys ====================
 
     /// Save public and secret keys to files
@@ -62,6 +92,44 @@ namespace sealcrypt {
     /// Save Galois keys
     auto saveGaloisKeys(const std::string& path) const -> bool;
 
+    // ==================== Seeded Export ====================
+    // SEAL can replace the random half of a freshly generated key by the
+    // seed it came from, which about halves the file. Only keys straight
+    // from the generator have a seed, so these write new keys made from
+    // the same secret key: equally valid, but not byte-identical to the
+    // ones held here. They load with the load*Key() functions. Need a
+    // secret key, from generate() or loaded.
+
+    /// Write a new public key in seeded form
+    auto exportPublicKey(const std::string& path) const -> bool;
+
+    /// Write new relinearization and Galois keys in seeded form, the Galois
+    /// keys for the same rotation steps as galoisKeys()
+    /// @param relin_path Destination for relin keys, empty to skip
+    /// @param galois_path Destination for Galois keys, empty to skip
+    /// @return false if a requested key was never generated or on I/O error
+    auto exportEvaluationKeys(const std::string& relin_path,
+                              const std::string& galois_path) const -> bool;
+
+    // ==================== Key Bundle ====================
+    // One file for every key instead of four, laid out so that a server
+    // can start without reading keys it never uses: the file is memory
+    // mapped and each key, and each Galois rotation step, is only
+    // deserialized when an accessor first asks for it.
+
+    /// Save all keys held to one file: a header with the encryption
+    /// parameters, an offset table, then each key, the Galois keys split
+    /// into one entry per rotation step
+    /// @return false if there are no keys or on I/O error
+    auto saveBundle(const std::string& path) const -> bool;
+
+    /// Replace all keys by those in a bundle written by saveBundle(). Only
+    /// the header is read here, the keys on first use; the file must stay
+    /// in place and unchanged until then. A corrupt key shows up as an
+    /// exception from its accessor.
+    /// @return false if the file is not a bundle for this context
+    auto loadBundle(const std::string& path) -> bool;
+
     // ==================== Load Keys ====================
 
     /// Load public and secret keys from files
@@ -108,6 +176,15 @@ namespace sealcrypt {
     /// Get Galois keys (throws if not available)
     [[nodiscard]] auto galoisKeys() const -> const seal::GaloisKeys&;
 
+    /// Get Galois keys for at least the given rotation steps (throws if no
+    /// Galois keys are available). The same object as galoisKeys(), but of
+    /// a loaded bundle only these steps are deserialized, or every step if
+    /// the bundle lacks one of them, since SEAL then composes the rotation
+    /// from others.
+    /// @param steps Row rotation steps, 0 for rotateColumns()
+    [[nodiscard]] auto galoisKeysFor(const std::vector< int >& steps) const
+        -> const seal::GaloisKeys&;
+
     // ==================== Error Handling ====================
 
     /// Get last error message
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "sealcrypt/context.hpp"
+#include "sealcrypt/homomorphic.hpp"
+#include "sealcrypt/homomorphic_vector.hpp"
+#include "sealcrypt/keys.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sealcrypt {
+
+  /// Cost of evaluating a polynomial of some degree with
+  /// evaluatePolynomial(), when every coefficient is non-zero
+  struct PolynomialCost {
+    /// Baby-step block size k (a power of two)
+    std::size_t baby_steps = 0;
+    /// Number of k-coefficient blocks
+    std::size_t giant_steps = 0;
+    /// Ciphertext-ciphertext multiplications
+    std::size_t multiplications = 0;
+    /// Multiplicative depth of the result
+    std::size_t depth = 0;
+  };
+
+  /// Schedule evaluatePolynomial() uses for a degree, chosen to need the
+  /// fewest ciphertext-ciphertext multiplications, then the least depth
+  /// (Horner's rule needs degree - 1 multiplications at depth degree - 1)
+  [[nodiscard]] auto polynomialCost(std::size_t degree) -> PolynomialCost;
+
+  /// Cost of evaluating these coefficients with evaluatePolynomial(), on
+  /// the schedule for their degree. Zero coefficients save the baby steps,
+  /// giant steps and products nothing else needs, so x^64 + 1 only costs
+  /// the six squarings up to x^64.
+  /// @param coeffs Coefficients, lowest power first
+  /// @param count Number of coefficients
+  /// @param ctx The crypto context, whose plain modulus reduces coeffs
+  [[nodiscard]] auto polynomialCost(const std::int64_t* coeffs,
+                                    std::size_t count,
+                                    const CryptoContext& ctx)
+      -> PolynomialCost;
+
+  [[nodiscard]] auto polynomialCost(const std::vector< std::int64_t >& coeffs,
+                                    const CryptoContext& ctx)
+      -> PolynomialCost;
+
+  /// Evaluate c[0] + c[1]*x + ... + c[n-1]*x^(n-1) with a baby-step
+  /// giant-step (Paterson-Stockmeyer) schedule:
+  ///  - powers x^1 .. x^(k-1) and x^k, x^2k, ... are each computed once by
+  ///    balanced products, at depth ceil(log2(e)), and relinearized
+  ///  - each block of k coefficients is a scalar combination of the baby
+  ///    steps (plaintext multiplications only)
+  ///  - blocks are multiplied by their giant step and summed, with one
+  ///    relinearization for the whole sum
+  /// Zero coefficients are skipped. Trailing zeros do not count toward the
+  /// degree.
+  /// @param x The encrypted argument
+  /// @param coeffs Coefficients, lowest power first
+  /// @param count Number of coefficients
+  /// @param ctx The crypto context
+  /// @param keys KeyPair with relinearization keys
+  /// @return The result, or an invalid value if x is invalid, keys has no
+  ///         relin keys or the polynomial is constant (a constant has no
+  ///         ciphertext to carry it)
+  auto evaluatePolynomial(const HomomorphicInt& x,
+                          const std::int64_t* coeffs,
+                          std::size_t count,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicInt;
+
+  auto evaluatePolynomial(const HomomorphicInt& x,
+                          const std::vector< std::int64_t >& coeffs,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicInt;
+
+  /// Evaluate the polynomial in every slot of a batched vector, see the
+  /// HomomorphicInt overload
+  auto evaluatePolynomial(const HomomorphicVector& x,
+                          const std::int64_t* coeffs,
+                          std::size_t count,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicVector;
+
+  auto evaluatePolynomial(const HomomorphicVector& x,
+                          const std::vector< std::int64_t >& coeffs,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicVector;
+
+} // namespace sealcrypt
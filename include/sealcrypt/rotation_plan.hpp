@@ -0,0 +1,32 @@
+#pragma once
+
+#include "sealcrypt/context.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace sealcrypt {
+
+  // Rotation steps a layout needs, to pass to
+  // KeyPair::generateGaloisKeys(steps). Each step is one Galois key, so
+  // generating only these instead of every power-of-two step cuts key
+  // memory, keygen time and transfer size. Step 0 stands for
+  // rotateColumns().
+
+  /// Steps HomomorphicVector::innerSum() rotates by
+  /// @param ctx The crypto context
+  /// @param count Slots summed, see innerSum(); 0 for all of them
+  /// @return 1, 2, 4, ... below count, plus 0 when both rows are summed
+  [[nodiscard]] auto innerSumSteps(const CryptoContext& ctx,
+                                   std::size_t count = 0) -> std::vector< int >;
+
+  /// Steps of a matrix-vector product in diagonal layout with the
+  /// baby-step giant-step schedule: with g = ceil(sqrt(dimension)), the
+  /// vector is rotated by 1 .. g-1 and each partial sum by a multiple of g.
+  /// About 2 * sqrt(dimension) keys where rotating by every diagonal would
+  /// take dimension - 1.
+  /// @param dimension Rows of the square matrix, at most slotCount() / 2
+  [[nodiscard]] auto matrixVectorSteps(std::size_t dimension)
+      -> std::vector< int >;
+
+} // namespace sealcrypt
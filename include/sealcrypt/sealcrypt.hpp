@@ -39,6 +39,11 @@
 #include "sealcrypt/context.hpp"
 #include "sealcrypt/decrypt.hpp"
 #include "sealcrypt/encrypt.hpp"
+#include "sealcrypt/expression.hpp"
 #include "sealcrypt/file_handler.hpp"
 #include "sealcrypt/homomorphic.hpp"
+#include "sealcrypt/homomorphic_vector.hpp"
 #include "sealcrypt/keys.hpp"
+#include "sealcrypt/polynomial.hpp"
+#include "sealcrypt/rotation_plan.hpp"
+#include "sealcrypt/session.hpp"
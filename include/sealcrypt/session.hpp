@@ -0,0 +1,81 @@
+#pragma once
+
+#include "sealcrypt/context.hpp"
+#include "sealcrypt/keys.hpp"
+
+#include <memory>
+#include <seal/seal.h>
+#include <string>
+
+namespace sealcrypt {
+
+  /// CryptoSession keeps long-lived SEAL encryptor and decryptor instances
+  /// for one CryptoContext + KeyPair, so hot loops do not pay for SEAL's
+  /// per-object precomputation and allocation on every call.
+  ///
+  /// A session is not thread safe (seal::Decryptor keeps scratch state).
+  /// Create one session per thread.
+  ///
+  /// Example usage:
+  /// @code
+  ///   CryptoSession session(ctx, keys);
+  ///   for(auto value : values) {
+  ///     auto enc = HomomorphicInt::encrypt(value, session);
+  ///     ...
+  ///     auto result = enc.decrypt(session);
+  ///   }
+  /// @endcode
+  class CryptoSession {
+  public:
+    /// Create a session for the given context and keys
+    /// An encryptor is created if either key is available (public-key
+    /// encryption needs the public key, symmetric encryption the secret
+    /// key), a decryptor if the secret key is available.
+    /// @param ctx The crypto context (must outlive this session)
+    /// @param keys The key pair (must outlive this session)
+    CryptoSession(const CryptoContext& ctx, const KeyPair& keys);
+
+    ~CryptoSession();
+
+    // Non-copyable, movable
+    CryptoSession(const CryptoSession&) = delete;
+    auto operator=(const CryptoSession&) -> CryptoSession& = delete;
+    CryptoSession(CryptoSession&&) noexcept;
+    auto operator=(CryptoSession&&) noexcept -> CryptoSession&;
+
+    /// Check if the session has at least an encryptor or a decryptor
+    [[nodiscard]] auto isValid() const -> bool;
+
+    /// Get last error message
+    [[nodiscard]] auto getLastError() const -> std::string;
+
+    /// Check if encryption is available (public key was present)
+    [[nodiscard]] auto hasEncryptor() const -> bool;
+
+    /// Check if symmetric encryption is available (secret key was present)
+    [[nodiscard]] auto hasSymmetricEncryptor() const -> bool;
+
+    /// Check if decryption is available (secret key was present)
+    [[nodiscard]] auto hasDecryptor() const -> bool;
+
+    /// Get the cached encryptor (throws if neither key was present)
+    [[nodiscard]] auto encryptor() const -> const seal::Encryptor&;
+
+    /// Get the cached decryptor (throws if not available)
+    [[nodiscard]] auto decryptor() const -> seal::Decryptor&;
+
+    /// Get the batch encoder (shared with the context)
+    [[nodiscard]] auto batchEncoder() const -> const seal::BatchEncoder&;
+
+    /// Get the context this session was created for
+    [[nodiscard]] auto context() const -> const CryptoContext&;
+
+    /// Get the keys this session was created for
+    [[nodiscard]] auto keys() const -> const KeyPair&;
+
+  private:
+    struct Impl;
+    std::unique_ptr< Impl > impl_;
+  };
+
+} // namespace sealcrypt
@@ -1,10 +1,94 @@
 #include "sealcrypt/context.hpp"
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
 namespace sealcrypt {
 
+  namespace {
+
+    /// Small LRU of encoded constant plaintexts keyed by the reduced value
+    class ConstantCache {
+    public:
+      using Entry = std::shared_ptr< const seal::Plaintext >;
+      using Node = std::pair< std::uint64_t, Entry >;
+
+      auto find(std::uint64_t key) -> Entry {
+        std::lock_guard< std::mutex > lock(mutex_);
+        auto it = index_.find(key);
+        if(it == index_.end()) {
+          return nullptr;
+        }
+        // move to front (most recently used)
+        order_.splice(order_.begin(), order_, it->second);
+        return it->second->second;
+      }
+
+      void insert(std::uint64_t key, Entry entry) {
+        std::lock_guard< std::mutex > lock(mutex_);
+        if(capacity_ == 0 || index_.count(key) != 0) {
+          return;
+        }
+        order_.emplace_front(key, std::move(entry));
+        index_[key] = order_.begin();
+        evict();
+      }
+
+      void setCapacity(std::size_t capacity) {
+        std::lock_guard< std::mutex > lock(mutex_);
+        capacity_ = capacity;
+        evict();
+      }
+
+    private:
+      void evict() {
+        while(order_.size() > capacity_) {
+          index_.erase(order_.back().first);
+          order_.pop_back();
+        }
+      }
+
+      std::list< Node > order_;
+      std::unordered_map< std::uint64_t, std::list< Node >::iterator > index_;
+      std::size_t capacity_ {256};
+      std::mutex mutex_;
+    };
+
+    /// Reduce value mod modulus, negatives wrap to modulus - |value|
+    auto reduceConstant(std::int64_t value, std::uint64_t modulus)
+        -> std::uint64_t {
+      if(value >= 0) {
+        return static_cast< std::uint64_t >(value) % modulus;
+      }
+      // -(value + 1) cannot overflow, even for INT64_MIN
+      auto magnitude = static_cast< std::uint64_t >(-(value + 1)) + 1;
+      return (modulus - magnitude % modulus) % modulus;
+    }
+
+    auto toSeal(Compression mode) -> seal::compr_mode_type {
+      switch(mode) {
+        case Compression::Zlib: return seal::compr_mode_type::zlib;
+        case Compression::Zstd: return seal::compr_mode_type::zstd;
+        default: return seal::compr_mode_type::none;
+      }
+    }
+
+  } // namespace
+
   struct CryptoContext::Impl {
     std::unique_ptr< seal::SEALContext > context;
     std::unique_ptr< seal::Evaluator > evaluator;
+    std::unique_ptr< seal::BatchEncoder > batch_encoder;
+    std::unique_ptr< seal::RelinKeys > relin_keys;
+    RelinPolicy relin_policy {RelinPolicy::Manual};
+    std::atomic< SavePolicy > save_policy {SavePolicy::Full};
+    ConstantCache constants;
+    // read by every save, possibly from pipeline worker threads
+    std::atomic< seal::compr_mode_type > compr_mode {
+        seal::Serialization::compr_mode_default};
     std::size_t poly_modulus_degree {0};
     std::uint64_t plain_modulus {0};
     std::string last_error; // TODO: not thread safe - can mutex to write?
@@ -29,6 +113,12 @@ namespace sealcrypt {
         }
 
         evaluator = std::make_unique< seal::Evaluator >(*context);
+
+        // batching needs a prime plain modulus congruent to 1 mod 2n,
+        // otherwise only the scalar (HomomorphicInt) path is available
+        if(context->first_context_data()->qualifiers().using_batching) {
+          batch_encoder = std::make_unique< seal::BatchEncoder >(*context);
+        }
         valid = true;
         return true;
 
@@ -85,6 +175,122 @@ namespace sealcrypt {
     return *impl_->evaluator;
   }
 
+  auto CryptoContext::batchEncoder() const -> const seal::BatchEncoder& {
+    if(!impl_ || !impl_->batch_encoder) {
+      throw std::runtime_error("Batching not supported by these parameters");
+    }
+    return *impl_->batch_encoder;
+  }
+
+  auto CryptoContext::supportsBatching() const -> bool {
+    return impl_ && impl_->batch_encoder != nullptr;
+  }
+
+  auto CryptoContext::slotCount() const -> std::size_t {
+    return supportsBatching() ? impl_->batch_encoder->slot_count() : 0;
+  }
+
+  auto CryptoContext::encodeConstant(std::int64_t value) const
+      -> std::shared_ptr< const seal::Plaintext > {
+    if(!isValid()) {
+      throw std::runtime_error("Invalid crypto context");
+    }
+    const std::uint64_t reduced = reduceConstant(value, impl_->plain_modulus);
+    if(auto cached = impl_->constants.find(reduced)) {
+      return cached;
+    }
+    auto plaintext = std::make_shared< seal::Plaintext >(1);
+    (*plaintext)[0] = reduced;
+    impl_->constants.insert(reduced, plaintext);
+    return plaintext;
+  }
+
+  void CryptoContext::encodeConstant(std::int64_t value,
+                                     seal::Plaintext& destination) const {
+    if(!isValid()) {
+      throw std::runtime_error("Invalid crypto context");
+    }
+    destination.resize(1);
+    destination[0] = reduceConstant(value, impl_->plain_modulus);
+  }
+
+  void CryptoContext::setConstantCacheCapacity(std::size_t capacity) {
+    if(impl_) {
+      impl_->constants.setCapacity(capacity);
+    }
+  }
+
+  auto CryptoContext::setCompression(Compression mode) -> bool {
+    if(!impl_) {
+      return false;
+    }
+    if(!isCompressionSupported(mode)) {
+      impl_->last_error = "Compression mode not supported by this SEAL build";
+      return false;
+    }
+    impl_->compr_mode = toSeal(mode);
+    return true;
+  }
+
+  auto CryptoContext::compression() const -> Compression {
+    switch(sealComprMode()) {
+      case seal::compr_mode_type::zlib: return Compression::Zlib;
+      case seal::compr_mode_type::zstd: return Compression::Zstd;
+      default: return Compression::None;
+    }
+  }
+
+  auto CryptoContext::sealComprMode() const -> seal::compr_mode_type {
+    return impl_ ? impl_->compr_mode.load() : seal::compr_mode_type::none;
+  }
+
+  auto CryptoContext::isCompressionSupported(Compression mode) -> bool {
+    return seal::Serialization::IsSupportedComprMode(toSeal(mode));
+  }
+
+  void CryptoContext::setRelinKeys(const seal::RelinKeys& relin_keys) {
+    if(impl_) {
+      impl_->relin_keys = std::make_unique< seal::RelinKeys >(relin_keys);
+    }
+  }
+
+  auto CryptoContext::hasRelinKeys() const -> bool {
+    return impl_ && impl_->relin_keys != nullptr;
+  }
+
+  auto CryptoContext::relinKeys() const -> const seal::RelinKeys& {
+    if(!hasRelinKeys()) {
+      throw std::runtime_error("No relin keys set on the context");
+    }
+    return *impl_->relin_keys;
+  }
+
+  auto CryptoContext::setRelinPolicy(RelinPolicy policy) -> bool {
+    if(!impl_) {
+      return false;
+    }
+    if(policy != RelinPolicy::Manual && !impl_->relin_keys) {
+      impl_->last_error = "Relinearization policy needs relin keys";
+      return false;
+    }
+    impl_->relin_policy = policy;
+    return true;
+  }
+
+  auto CryptoContext::relinPolicy() const -> RelinPolicy {
+    return impl_ ? impl_->relin_policy : RelinPolicy::Manual;
+  }
+
+  void CryptoContext::setSavePolicy(SavePolicy policy) {
+    if(impl_) {
+      impl_->save_policy = policy;
+    }
+  }
+
+  auto CryptoContext::savePolicy() const -> SavePolicy {
+    return impl_ ? impl_->save_policy.load() : SavePolicy::Full;
+  }
+
   auto CryptoContext::polyModulusDegree() const -> std::size_t {
     return impl_ ? impl_->poly_modulus_degree : 0;
   }
@@ -1,35 +1,236 @@
 #include "sealcrypt/decrypt.hpp"
 
+#include "file_format.hpp"
+#include "ordered_pipeline.hpp"
+#include "serialization.hpp"
 #include "sealcrypt/file_handler.hpp"
 
-#include <sstream>
+#include <algorithm>
 
 namespace sealcrypt {
 
   struct Decryptor::Impl {
     const CryptoContext& ctx;
+    std::size_t threads = 0;
     std::string last_error;
 
     explicit Impl(const CryptoContext& context) : ctx(context) {
     }
 
-    auto processDecrypted(const std::vector< seal::Plaintext >& plaintexts,
-                          std::size_t original_size)
+    // Per-thread SEAL state for the parallel pipeline. SEAL gives every
+    // Decryptor its own memory pool.
+    struct Worker {
+      seal::Decryptor decryptor;
+      seal::Ciphertext ciphertext;
+      seal::Plaintext plaintext;
+
+      Worker(const seal::SEALContext& context,
+             const seal::SecretKey& secret_key) :
+          decryptor(context, secret_key) {
+      }
+    };
+
+    // One chunk handed from the reader to a worker
+    struct Chunk {
+      std::string ciphertext;
+      std::size_t length = 0;
+    };
+
+    // Reads the header written by Encryptor (or the legacy headerless
+    // layout), then decrypts and writes out each chunk in order, so memory
+    // use stays constant. With one thread the given decryptor does all the
+    // work; otherwise each worker builds its own from `secret_key`.
+    auto writeDecrypted(std::istream& in,
+                        seal::Decryptor& decryptor,
+                        const seal::SecretKey& secret_key,
+                        std::ostream& out) -> bool {
+      detail::FileHeader header;
+      if(!detail::readHeader(
+             in, ctx.sealContext(), false, header, last_error)) {
+        return false;
+      }
+
+      const auto chunk_bytes = header.packing.chunkBytes();
+      const auto thread_count = std::min< std::size_t >(
+          detail::resolveThreadCount(threads), header.chunk_count);
+      if(thread_count <= 1) {
+        std::vector< std::uint8_t > buffer(chunk_bytes);
+        seal::Ciphertext ciphertext;
+        seal::Plaintext plaintext;
+        std::size_t remaining = header.original_size;
+        for(std::size_t i = 0; i < header.chunk_count; ++i) {
+          ciphertext.load(ctx.sealContext(), in);
+          decryptor.decrypt(ciphertext, plaintext);
+
+          std::size_t length = std::min(chunk_bytes, remaining);
+          detail::unpackChunk(plaintext, header.packing, buffer.data(), length);
+          out.write(reinterpret_cast< const char* >(buffer.data()),
+                    static_cast< std::streamsize >(length));
+          remaining -= length;
+        }
+        return true;
+      }
+
+      std::vector< std::unique_ptr< Worker > > workers;
+      for(std::size_t i = 0; i < thread_count; ++i) {
+        workers.push_back(
+            std::make_unique< Worker >(ctx.sealContext(), secret_key));
+      }
+
+      std::size_t remaining = header.original_size;
+      detail::runOrderedPipeline< Chunk, std::vector< std::uint8_t > >(
+          thread_count,
+          [&](Chunk& chunk) {
+            if(remaining == 0) {
+              return false;
+            }
+            detail::readSerialized(in, chunk.ciphertext);
+            chunk.length = std::min(chunk_bytes, remaining);
+            remaining -= chunk.length;
+            return true;
+          },
+          [&](std::size_t index, Chunk& chunk) {
+            auto& worker = *workers[index];
+            worker.ciphertext.load(
+                ctx.sealContext(),
+                reinterpret_cast< const seal::seal_byte* >(
+                    chunk.ciphertext.data()),
+                chunk.ciphertext.size());
+            worker.decryptor.decrypt(worker.ciphertext, worker.plaintext);
+
+            std::vector< std::uint8_t > bytes(chunk.length);
+            detail::unpackChunk(
+                worker.plaintext, header.packing, bytes.data(), bytes.size());
+            return bytes;
+          },
+          [&](std::vector< std::uint8_t >& bytes) {
+            out.write(reinterpret_cast< const char* >(bytes.data()),
+                      static_cast< std::streamsize >(bytes.size()));
+          });
+      return true;
+    }
+
+    // Decrypts only the chunks overlapping [offset, offset + length). With
+    // an offset table the reader seeks straight to the first of them; older
+    // data without one is skipped over ciphertext by ciphertext, using the
+    // SEAL headers only.
+    auto readRange(std::istream& in,
+                   std::uint64_t offset,
+                   std::size_t length,
+                   seal::Decryptor& decryptor,
+                   std::vector< std::uint8_t >& result) -> bool {
+      const auto base = in.tellg();
+      detail::FileHeader header;
+      if(!detail::readHeader(
+             in, ctx.sealContext(), true, header, last_error)) {
+        return false;
+      }
+
+      if(offset > header.original_size) {
+        last_error = "Range starts past the end of the data";
+        return false;
+      }
+      length = static_cast< std::size_t >(
+          std::min< std::uint64_t >(length, header.original_size - offset));
+      result.assign(length, 0);
+      if(length == 0) {
+        return true;
+      }
+
+      const auto chunk_bytes = header.packing.chunkBytes();
+      const auto first = offset / chunk_bytes;
+      const auto last = (offset + length - 1) / chunk_bytes;
+
+      if(header.hasOffsets()) {
+        in.seekg(base + static_cast< std::streamoff >(header.offsets[first]));
+      } else {
+        for(std::uint64_t i = 0; i < first; ++i) {
+          detail::skipSerialized(in);
+        }
+      }
+
+      std::vector< std::uint8_t > buffer(chunk_bytes);
+      seal::Ciphertext ciphertext;
+      seal::Plaintext plaintext;
+      for(auto i = first; i <= last; ++i) {
+        ciphertext.load(ctx.sealContext(), in);
+        decryptor.decrypt(ciphertext, plaintext);
+
+        const auto chunk_start = i * chunk_bytes;
+        const auto chunk_length = static_cast< std::size_t >(
+            std::min< std::uint64_t >(chunk_bytes,
+                                      header.original_size - chunk_start));
+        detail::unpackChunk(
+            plaintext, header.packing, buffer.data(), chunk_length);
+
+        const auto from = std::max(offset, chunk_start);
+        const auto to =
+            std::min(offset + length, chunk_start + chunk_length);
+        std::copy_n(buffer.data() + (from - chunk_start),
+                    to - from,
+                    result.data() + (from - offset));
+      }
+
+      return true;
+    }
+
+    auto decryptRange(const std::string& input_path,
+                      std::uint64_t offset,
+                      std::size_t length,
+                      seal::Decryptor& decryptor)
         -> std::vector< std::uint8_t > {
+      auto input_file = FileHandler::openForReading(input_path, last_error);
+      if(!input_file) {
+        return {};
+      }
+
       std::vector< std::uint8_t > result;
-      result.reserve(original_size);
-
-      // Process each plaintext
-      for(const auto& plaintext : plaintexts) {
-        for(std::size_t i = 0; i < plaintext.coeff_count(); ++i) {
-          if(result.size() >= original_size) {
-            break; // Stop at original size to avoid padding bytes
-          }
-          // Include ALL bytes, even zeros (this fixes the zero-byte bug)
-          result.push_back(static_cast< std::uint8_t >(plaintext[i]));
-        }
+      if(!readRange(*input_file, offset, length, decryptor, result)) {
+        return {};
+      }
+      return result;
+    }
+
+    auto decryptFile(const std::string& input_path,
+                     const std::string& output_path,
+                     seal::Decryptor& decryptor,
+                     const seal::SecretKey& secret_key) -> bool {
+      auto input_file = FileHandler::openForReading(input_path, last_error);
+      if(!input_file) {
+        return false;
+      }
+
+      auto output_file = FileHandler::openForWriting(output_path, last_error);
+      if(!output_file) {
+        return false;
+      }
+
+      if(!writeDecrypted(*input_file, decryptor, secret_key, *output_file)) {
+        return false;
+      }
+
+      output_file->flush();
+      if(!*output_file) {
+        last_error = "Error writing to file: " + output_path;
+        return false;
       }
 
+      return true;
+    }
+
+    // The input is read in place and the output appended straight to the
+    // result, neither side goes through an intermediate string
+    auto decryptBytes(const std::byte* data,
+                      std::size_t size,
+                      seal::Decryptor& decryptor,
+                      const seal::SecretKey& secret_key)
+        -> std::vector< std::uint8_t > {
+      detail::ByteSource in(data, size);
+      std::vector< std::uint8_t > result;
+      detail::ByteSink out(result);
+      if(!writeDecrypted(in, decryptor, secret_key, out)) {
+        return {};
+      }
       return result;
     }
   };
@@ -57,49 +258,64 @@ namespace sealcrypt {
         return false;
       }
 
-      // Open encrypted file using FileHandler
-      auto input_file
-          = FileHandler::openForReading(input_path, impl_->last_error);
-      if(!input_file) {
-        return false;
-      }
-
-      // Read header: original data size
-      std::size_t original_size = 0;
-      input_file->read(reinterpret_cast< char* >(&original_size),
-                       sizeof(original_size));
-
-      // Read number of ciphertexts
-      std::size_t ciphertext_count = 0;
-      input_file->read(reinterpret_cast< char* >(&ciphertext_count),
-                       sizeof(ciphertext_count));
-
       // Create SEAL decryptor
       seal::Decryptor decryptor(impl_->ctx.sealContext(), keys.secretKey());
+      return impl_->decryptFile(
+          input_path, output_path, decryptor, keys.secretKey());
+    } catch(const std::exception& e) {
+      impl_->last_error = "Decryption failed: " + std::string(e.what());
+      return false;
+    }
+  }
 
-      // Decrypt each ciphertext
-      std::vector< seal::Plaintext > plaintexts;
-      plaintexts.reserve(ciphertext_count);
+  auto Decryptor::decryptBytes(const std::vector< std::uint8_t >& data,
+                               const KeyPair& keys)
+      -> std::vector< std::uint8_t > {
+    return decryptBytes(
+        reinterpret_cast< const std::byte* >(data.data()), data.size(), keys);
+  }
 
-      for(std::size_t i = 0; i < ciphertext_count; ++i) {
-        seal::Ciphertext ciphertext;
-        ciphertext.load(impl_->ctx.sealContext(), *input_file);
+  auto Decryptor::decryptBytes(const std::byte* data,
+                               std::size_t size,
+                               const KeyPair& keys)
+      -> std::vector< std::uint8_t > {
+    try {
+      if(!impl_->ctx.isValid()) {
+        impl_->last_error = "Invalid crypto context";
+        return {};
+      }
 
-        seal::Plaintext plaintext;
-        decryptor.decrypt(ciphertext, plaintext);
-        plaintexts.push_back(std::move(plaintext));
+      if(!keys.hasSecretKey()) {
+        impl_->last_error = "No secret key available";
+        return {};
       }
 
-      // Process decrypted data with correct size
-      auto decrypted_data = impl_->processDecrypted(plaintexts, original_size);
+      seal::Decryptor decryptor(impl_->ctx.sealContext(), keys.secretKey());
+      return impl_->decryptBytes(data, size, decryptor, keys.secretKey());
+    } catch(const std::exception& e) {
+      impl_->last_error = "Decryption failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  auto Decryptor::decryptFile(const std::string& input_path,
+                              const std::string& output_path,
+                              const CryptoSession& session) -> bool {
+    try {
+      if(!impl_->ctx.isValid()) {
+        impl_->last_error = "Invalid crypto context";
+        return false;
+      }
 
-      // Write output file using FileHandler
-      if(!FileHandler::writeFile(
-             output_path, decrypted_data, impl_->last_error)) {
+      if(!session.hasDecryptor()) {
+        impl_->last_error = "Session has no decryptor";
         return false;
       }
 
-      return true;
+      return impl_->decryptFile(input_path,
+                                 output_path,
+                                 session.decryptor(),
+                                 session.keys().secretKey());
     } catch(const std::exception& e) {
       impl_->last_error = "Decryption failed: " + std::string(e.what());
       return false;
@@ -107,7 +323,16 @@ namespace sealcrypt {
   }
 
   auto Decryptor::decryptBytes(const std::vector< std::uint8_t >& data,
-                               const KeyPair& keys)
+                               const CryptoSession& session)
+      -> std::vector< std::uint8_t > {
+    return decryptBytes(reinterpret_cast< const std::byte* >(data.data()),
+                        data.size(),
+                        session);
+  }
+
+  auto Decryptor::decryptBytes(const std::byte* data,
+                               std::size_t size,
+                               const CryptoSession& session)
       -> std::vector< std::uint8_t > {
     try {
       if(!impl_->ctx.isValid()) {
@@ -115,43 +340,75 @@ namespace sealcrypt {
         return {};
       }
 
-      if(!keys.hasSecretKey()) {
-        impl_->last_error = "No secret key available";
+      if(!session.hasDecryptor()) {
+        impl_->last_error = "Session has no decryptor";
         return {};
       }
 
-      std::istringstream iss(std::string(data.begin(), data.end()),
-                             std::ios::binary);
+      return impl_->decryptBytes(
+          data, size, session.decryptor(), session.keys().secretKey());
+    } catch(const std::exception& e) {
+      impl_->last_error = "Decryption failed: " + std::string(e.what());
+      return {};
+    }
+  }
 
-      // Read original size
-      std::size_t original_size = 0;
-      iss.read(reinterpret_cast< char* >(&original_size),
-               sizeof(original_size));
+  auto Decryptor::decryptRange(const std::string& input_path,
+                                std::uint64_t offset,
+                                std::size_t length,
+                                const KeyPair& keys)
+      -> std::vector< std::uint8_t > {
+    try {
+      if(!impl_->ctx.isValid()) {
+        impl_->last_error = "Invalid crypto context";
+        return {};
+      }
 
-      // Read count
-      std::size_t ciphertext_count = 0;
-      iss.read(reinterpret_cast< char* >(&ciphertext_count),
-               sizeof(ciphertext_count));
+      if(!keys.hasSecretKey()) {
+        impl_->last_error = "No secret key available";
+        return {};
+      }
 
       seal::Decryptor decryptor(impl_->ctx.sealContext(), keys.secretKey());
+      return impl_->decryptRange(input_path, offset, length, decryptor);
+    } catch(const std::exception& e) {
+      impl_->last_error = "Decryption failed: " + std::string(e.what());
+      return {};
+    }
+  }
 
-      std::vector< seal::Plaintext > plaintexts;
-      for(std::size_t i = 0; i < ciphertext_count; ++i) {
-        seal::Ciphertext ciphertext;
-        ciphertext.load(impl_->ctx.sealContext(), iss);
+  auto Decryptor::decryptRange(const std::string& input_path,
+                                std::uint64_t offset,
+                                std::size_t length,
+                                const CryptoSession& session)
+      -> std::vector< std::uint8_t > {
+    try {
+      if(!impl_->ctx.isValid()) {
+        impl_->last_error = "Invalid crypto context";
+        return {};
+      }
 
-        seal::Plaintext plaintext;
-        decryptor.decrypt(ciphertext, plaintext);
-        plaintexts.push_back(std::move(plaintext));
+      if(!session.hasDecryptor()) {
+        impl_->last_error = "Session has no decryptor";
+        return {};
       }
 
-      return impl_->processDecrypted(plaintexts, original_size);
+      return impl_->decryptRange(
+          input_path, offset, length, session.decryptor());
     } catch(const std::exception& e) {
       impl_->last_error = "Decryption failed: " + std::string(e.what());
       return {};
     }
   }
 
+  void Decryptor::setThreadCount(std::size_t threads) {
+    impl_->threads = threads;
+  }
+
+  auto Decryptor::threadCount() const -> std::size_t {
+    return detail::resolveThreadCount(impl_->threads);
+  }
+
   auto Decryptor::getLastError() const -> std::string {
     return impl_->last_error;
   }
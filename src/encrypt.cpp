@@ -1,39 +1,242 @@
 #include "sealcrypt/encrypt.hpp"
 
+#include "file_format.hpp"
+#include "noise_model.hpp"
+#include "ordered_pipeline.hpp"
 #include "sealcrypt/file_handler.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <sstream>
+#include <stdexcept>
 
 namespace sealcrypt {
 
   struct Encryptor::Impl {
     const CryptoContext& ctx;
+    PackingMode packing_mode = PackingMode::Dense;
+    EncryptionMode encryption_mode = EncryptionMode::PublicKey;
+    std::size_t threads = 0;
     std::string last_error;
 
     explicit Impl(const CryptoContext& context) : ctx(context) {
     }
 
-    auto preparePlaintexts(const std::vector< std::uint8_t >& data)
-        -> std::vector< seal::Plaintext > {
-      std::vector< seal::Plaintext > plaintexts;
+    auto packing() const -> detail::Packing {
+      if(packing_mode == PackingMode::Sparse) {
+        return detail::sparsePacking();
+      }
+      return detail::densePacking(ctx.polyModulusDegree(), ctx.plainModulus());
+    }
+
+    // Fills dest with the next `length` input bytes, throws on failure
+    using ReadFn = std::function< void(std::uint8_t* dest, std::size_t) >;
+
+    auto symmetric() const -> bool {
+      return encryption_mode == EncryptionMode::Symmetric;
+    }
+
+    // Check that keys hold the key the current mode encrypts with
+    auto checkKeys(const KeyPair& keys) -> bool {
+      if(symmetric() ? !keys.hasSecretKey() : !keys.hasPublicKey()) {
+        last_error = symmetric() ? "No secret key available"
+                                 : "No public key available";
+        return false;
+      }
+      return true;
+    }
+
+    auto checkSession(const CryptoSession& session) -> bool {
+      if(symmetric() ? !session.hasSymmetricEncryptor()
+                     : !session.hasEncryptor()) {
+        last_error = symmetric() ? "Session has no symmetric encryptor"
+                                 : "Session has no encryptor";
+        return false;
+      }
+      return true;
+    }
 
-      // Use a reasonable batch size based on plain modulus
-      // Each byte is stored as one coefficient
-      const std::size_t batch_size = 1024;
+    auto makeEncryptor(const KeyPair& keys) const
+        -> std::unique_ptr< seal::Encryptor > {
+      if(symmetric()) {
+        return std::make_unique< seal::Encryptor >(ctx.sealContext(),
+                                                   keys.secretKey());
+      }
+      return std::make_unique< seal::Encryptor >(ctx.sealContext(),
+                                                 keys.publicKey());
+    }
 
-      for(std::size_t i = 0; i < data.size(); i += batch_size) {
+    // Encrypt one plaintext and save it, as a seeded ciphertext in symmetric
+    // mode, otherwise at the level the save policy asks for. Returns the
+    // number of bytes written.
+    auto saveEncrypted(const seal::Encryptor& encryptor,
+                       const seal::Plaintext& plaintext,
+                       seal::Ciphertext& ciphertext,
+                       const seal::MemoryPoolHandle& pool,
+                       std::ostream& out) const -> std::uint64_t {
+      const auto mode = ctx.sealComprMode();
+      if(symmetric()) {
+        return static_cast< std::uint64_t >(
+            encryptor.encrypt_symmetric(plaintext, pool).save(out, mode));
+      }
+      encryptor.encrypt(plaintext, ciphertext, pool);
+      if(ctx.savePolicy() == SavePolicy::Compact) {
+        ctx.evaluator().mod_switch_to_inplace(
+            ciphertext,
+            detail::compactLevel(ctx, ciphertext.parms_id(), 0),
+            pool);
+      }
+      return static_cast< std::uint64_t >(ciphertext.save(out, mode));
+    }
+
+    // Per-thread SEAL state for the parallel pipeline
+    struct Worker {
+      seal::MemoryPoolHandle pool = seal::MemoryPoolHandle::New();
+      std::unique_ptr< seal::Encryptor > encryptor;
+      seal::Plaintext plaintext {pool};
+      seal::Ciphertext ciphertext {pool};
+    };
+
+    // Encrypts `size` bytes taken from `read` one chunk at a time, so memory
+    // use is bounded no matter how large the input is. With one thread the
+    // given encryptor does all the work; otherwise each worker builds its own
+    // from `keys` and ciphertexts are written in chunk order.
+    void writeEncrypted(std::size_t size,
+                        const ReadFn& read,
+                        const seal::Encryptor& encryptor,
+                        const KeyPair& keys,
+                        std::ostream& out) {
+      const auto packing = this->packing();
+      const auto chunk_bytes = packing.chunkBytes();
+
+      // The offset table is written as zeros first and patched at the end,
+      // once every ciphertext's size is known
+      auto header =
+          detail::FileHeader::create(ctx.sealContext(), packing, size);
+      const auto header_pos = out.tellp();
+      detail::writeHeader(header, out);
+      header.offsets.reserve(header.chunk_count + 1);
+      header.offsets.push_back(header.size());
+      auto record = [&](std::uint64_t bytes) {
+        header.offsets.push_back(header.offsets.back() + bytes);
+      };
+
+      const auto thread_count = std::min(detail::resolveThreadCount(threads),
+                                         packing.chunkCount(size));
+      if(thread_count <= 1) {
+        // The plaintext, ciphertext and buffer are reused across chunks so
+        // they are only allocated once
+        std::vector< std::uint8_t > buffer(std::min(chunk_bytes, size));
+        const auto pool = seal::MemoryManager::GetPool();
         seal::Plaintext plaintext;
-        std::size_t current_batch = std::min(batch_size, data.size() - i);
-        plaintext.resize(current_batch);
+        seal::Ciphertext ciphertext;
+        for(std::size_t remaining = size; remaining > 0;) {
+          std::size_t length = std::min(chunk_bytes, remaining);
+          read(buffer.data(), length);
+          detail::packChunk(buffer.data(), length, packing, plaintext);
+          record(saveEncrypted(
+              encryptor, plaintext, ciphertext, pool, out));
+          remaining -= length;
+        }
+        detail::writeOffsets(header, out, header_pos);
+        return;
+      }
+
+      std::vector< std::unique_ptr< Worker > > workers;
+      for(std::size_t i = 0; i < thread_count; ++i) {
+        auto worker = std::make_unique< Worker >();
+        worker->encryptor = makeEncryptor(keys);
+        workers.push_back(std::move(worker));
+      }
 
-        for(std::size_t j = 0; j < current_batch; ++j) {
-          plaintext[j] = static_cast< std::uint64_t >(data[i + j]);
+      std::size_t remaining = size;
+      detail::runOrderedPipeline< std::vector< std::uint8_t >, std::string >(
+          thread_count,
+          [&](std::vector< std::uint8_t >& chunk) {
+            if(remaining == 0) {
+              return false;
+            }
+            chunk.resize(std::min(chunk_bytes, remaining));
+            read(chunk.data(), chunk.size());
+            remaining -= chunk.size();
+            return true;
+          },
+          [&](std::size_t index, std::vector< std::uint8_t >& chunk) {
+            auto& worker = *workers[index];
+            detail::packChunk(
+                chunk.data(), chunk.size(), packing, worker.plaintext);
+            std::ostringstream oss(std::ios::binary);
+            saveEncrypted(*worker.encryptor,
+                          worker.plaintext,
+                          worker.ciphertext,
+                          worker.pool,
+                          oss);
+            return oss.str();
+          },
+          [&](std::string& bytes) {
+            out.write(bytes.data(),
+                      static_cast< std::streamsize >(bytes.size()));
+            record(bytes.size());
+          });
+      detail::writeOffsets(header, out, header_pos);
+    }
+
+    auto encryptFile(const std::string& input_path,
+                     const std::string& output_path,
+                     const seal::Encryptor& encryptor,
+                     const KeyPair& keys) -> bool {
+      auto input_file = FileHandler::openForReading(input_path, last_error);
+      if(!input_file) {
+        return false;
+      }
+
+      // Size up front, the header records it before any ciphertext. A pipe
+      // has no size to record.
+      input_file->seekg(0, std::ios::end);
+      const auto end = input_file->tellg();
+      if(end == std::istream::pos_type(-1)) {
+        last_error = "Cannot encrypt " + input_path + ": input is not seekable";
+        return false;
+      }
+      const auto size = static_cast< std::size_t >(end);
+      input_file->seekg(0, std::ios::beg);
+
+      auto output_file = FileHandler::openForWriting(output_path, last_error);
+      if(!output_file) {
+        return false;
+      }
+
+      auto read = [&](std::uint8_t* dest, std::size_t length) {
+        input_file->read(reinterpret_cast< char* >(dest),
+                         static_cast< std::streamsize >(length));
+        if(!*input_file) {
+          throw std::runtime_error("Error reading file: " + input_path);
         }
+      };
+      writeEncrypted(size, read, encryptor, keys, *output_file);
 
-        plaintexts.push_back(std::move(plaintext));
+      output_file->flush();
+      if(!*output_file) {
+        last_error = "Error writing to file: " + output_path;
+        return false;
       }
 
-      return plaintexts;
+      return true;
+    }
+
+    auto encryptBytes(const std::vector< std::uint8_t >& data,
+                      const seal::Encryptor& encryptor,
+                      const KeyPair& keys) -> std::vector< std::uint8_t > {
+      std::size_t offset = 0;
+      auto read = [&](std::uint8_t* dest, std::size_t length) {
+        std::copy_n(data.data() + offset, length, dest);
+        offset += length;
+      };
+
+      std::ostringstream oss(std::ios::binary);
+      writeEncrypted(data.size(), read, encryptor, keys, oss);
+      std::string str = oss.str();
+      return std::vector< std::uint8_t >(str.begin(), str.end());
     }
   };
 
@@ -55,48 +258,55 @@ namespace sealcrypt {
         return false;
       }
 
-      if(!keys.hasPublicKey()) {
-        impl_->last_error = "No public key available";
-        return false;
-      }
-
-      // Read input file using FileHandler
-      std::vector< std::uint8_t > input_data;
-      if(!FileHandler::readFile(input_path, input_data, impl_->last_error)) {
+      if(!impl_->checkKeys(keys)) {
         return false;
       }
 
       // Create SEAL encryptor
-      seal::Encryptor encryptor(impl_->ctx.sealContext(), keys.publicKey());
+      auto encryptor = impl_->makeEncryptor(keys);
+      return impl_->encryptFile(input_path, output_path, *encryptor, keys);
+    } catch(const std::exception& e) {
+      impl_->last_error = "Encryption failed: " + std::string(e.what());
+      return false;
+    }
+  }
 
-      // Prepare plaintexts
-      auto plaintexts = impl_->preparePlaintexts(input_data);
+  auto Encryptor::encryptBytes(const std::vector< std::uint8_t >& data,
+                               const KeyPair& keys)
+      -> std::vector< std::uint8_t > {
+    try {
+      if(!impl_->ctx.isValid()) {
+        impl_->last_error = "Invalid crypto context";
+        return {};
+      }
 
-      // Open output file using FileHandler
-      auto output_file
-          = FileHandler::openForWriting(output_path, impl_->last_error);
-      if(!output_file) {
-        return false;
+      if(!impl_->checkKeys(keys)) {
+        return {};
       }
 
-      // Write header: original data size (for correct decryption)
-      std::size_t original_size = input_data.size();
-      output_file->write(reinterpret_cast< const char* >(&original_size),
-                         sizeof(original_size));
+      auto encryptor = impl_->makeEncryptor(keys);
+      return impl_->encryptBytes(data, *encryptor, keys);
+    } catch(const std::exception& e) {
+      impl_->last_error = "Encryption failed: " + std::string(e.what());
+      return {};
+    }
+  }
 
-      // Write number of ciphertexts
-      std::size_t count = plaintexts.size();
-      output_file->write(reinterpret_cast< const char* >(&count),
-                         sizeof(count));
+  auto Encryptor::encryptFile(const std::string& input_path,
+                              const std::string& output_path,
+                              const CryptoSession& session) -> bool {
+    try {
+      if(!impl_->ctx.isValid()) {
+        impl_->last_error = "Invalid crypto context";
+        return false;
+      }
 
-      // Encrypt and save each plaintext
-      for(const auto& plaintext : plaintexts) {
-        seal::Ciphertext ciphertext;
-        encryptor.encrypt(plaintext, ciphertext);
-        ciphertext.save(*output_file);
+      if(!impl_->checkSession(session)) {
+        return false;
       }
 
-      return true;
+      return impl_->encryptFile(
+          input_path, output_path, session.encryptor(), session.keys());
     } catch(const std::exception& e) {
       impl_->last_error = "Encryption failed: " + std::string(e.what());
       return false;
@@ -104,7 +314,7 @@ namespace sealcrypt {
   }
 
   auto Encryptor::encryptBytes(const std::vector< std::uint8_t >& data,
-                               const KeyPair& keys)
+                               const CryptoSession& session)
       -> std::vector< std::uint8_t > {
     try {
       if(!impl_->ctx.isValid()) {
@@ -112,39 +322,39 @@ namespace sealcrypt {
         return {};
       }
 
-      if(!keys.hasPublicKey()) {
-        impl_->last_error = "No public key available";
+      if(!impl_->checkSession(session)) {
         return {};
       }
 
-      seal::Encryptor encryptor(impl_->ctx.sealContext(), keys.publicKey());
-      auto plaintexts = impl_->preparePlaintexts(data);
+      return impl_->encryptBytes(data, session.encryptor(), session.keys());
+    } catch(const std::exception& e) {
+      impl_->last_error = "Encryption failed: " + std::string(e.what());
+      return {};
+    }
+  }
 
-      // Serialize to bytes
-      std::ostringstream oss(std::ios::binary);
+  void Encryptor::setPackingMode(PackingMode mode) {
+    impl_->packing_mode = mode;
+  }
 
-      // Write original size
-      std::size_t original_size = data.size();
-      oss.write(reinterpret_cast< const char* >(&original_size),
-                sizeof(original_size));
+  auto Encryptor::packingMode() const -> PackingMode {
+    return impl_->packing_mode;
+  }
 
-      // Write count
-      std::size_t count = plaintexts.size();
-      oss.write(reinterpret_cast< const char* >(&count), sizeof(count));
+  void Encryptor::setEncryptionMode(EncryptionMode mode) {
+    impl_->encryption_mode = mode;
+  }
 
-      // Encrypt each plaintext
-      for(const auto& plaintext : plaintexts) {
-        seal::Ciphertext ciphertext;
-        encryptor.encrypt(plaintext, ciphertext);
-        ciphertext.save(oss);
-      }
+  auto Encryptor::encryptionMode() const -> EncryptionMode {
+    return impl_->encryption_mode;
+  }
 
-      std::string str = oss.str();
-      return std::vector< std::uint8_t >(str.begin(), str.end());
-    } catch(const std::exception& e) {
-      impl_->last_error = "Encryption failed: " + std::string(e.what());
-      return {};
-    }
+  void Encryptor::setThreadCount(std::size_t threads) {
+    impl_->threads = threads;
+  }
+
+  auto Encryptor::threadCount() const -> std::size_t {
+    return detail::resolveThreadCount(impl_->threads);
   }
 
   auto Encryptor::getLastError() const -> std::string {
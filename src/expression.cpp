@@ -0,0 +1,427 @@
+#include "sealcrypt/expression.hpp"
+
+#include "noise_model.hpp"
+
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace sealcrypt {
+
+  namespace detail {
+
+    enum class ExpressionOp {
+      Leaf,
+      Add,
+      Sub,
+      Mul,
+      Negate,
+      AddPlain,
+      SubPlain,
+      MulPlain
+    };
+
+    struct ExpressionNode {
+      ExpressionOp op {ExpressionOp::Leaf};
+      std::shared_ptr< const ExpressionNode > lhs;
+      std::shared_ptr< const ExpressionNode > rhs;
+      const HomomorphicInt* leaf {nullptr};
+      std::shared_ptr< const HomomorphicInt > owned; // keeps owned leaves alive
+      std::int64_t constant {0};
+    };
+
+  } // namespace detail
+
+  namespace {
+
+    using detail::ExpressionNode;
+    using detail::ExpressionOp;
+
+    auto isBinary(ExpressionOp op) -> bool {
+      return op == ExpressionOp::Add || op == ExpressionOp::Sub ||
+             op == ExpressionOp::Mul;
+    }
+
+    /// The DAG flattened into steps in evaluation order, with structurally
+    /// equal subexpressions merged into one step
+    class Plan {
+    public:
+      explicit Plan(const ExpressionNode& root) : root_(add(root)) {
+        steps_[root_].uses += 1; // the caller reads the root
+      }
+
+      [[nodiscard]] auto operationCount() const -> std::size_t {
+        std::size_t count = 0;
+        for(const auto& step : steps_) {
+          count += step.op == ExpressionOp::Leaf ? 0 : 1;
+        }
+        return count;
+      }
+
+      auto run(const CryptoContext& ctx) const -> HomomorphicInt;
+
+    private:
+      struct Step {
+        ExpressionOp op {ExpressionOp::Leaf};
+        std::size_t lhs {0};
+        std::size_t rhs {0};
+        const HomomorphicInt* leaf {nullptr};
+        std::int64_t constant {0};
+        std::size_t uses {0}; // how many operand slots read this step
+      };
+
+      // op, operands, leaf and constant identify a step
+      using Key = std::tuple< ExpressionOp,
+                              std::size_t,
+                              std::size_t,
+                              const HomomorphicInt*,
+                              std::int64_t >;
+
+      auto add(const ExpressionNode& node) -> std::size_t {
+        auto seen = visited_.find(&node);
+        if(seen != visited_.end()) {
+          return seen->second;
+        }
+
+        Step step;
+        step.op = node.op;
+        step.leaf = node.leaf;
+        step.constant = node.constant;
+        if(node.lhs) {
+          step.lhs = add(*node.lhs);
+        }
+        if(node.rhs) {
+          step.rhs = add(*node.rhs);
+        }
+        // a + b and b + a (or a * b and b * a) are the same step
+        if((step.op == ExpressionOp::Add || step.op == ExpressionOp::Mul) &&
+           step.lhs > step.rhs) {
+          std::swap(step.lhs, step.rhs);
+        }
+
+        Key key {step.op, step.lhs, step.rhs, step.leaf, step.constant};
+        auto [it, inserted] = index_.emplace(key, steps_.size());
+        if(inserted) {
+          if(step.op != ExpressionOp::Leaf) {
+            steps_[step.lhs].uses += 1;
+          }
+          if(isBinary(step.op)) {
+            steps_[step.rhs].uses += 1;
+          }
+          steps_.push_back(step);
+        }
+        visited_.emplace(&node, it->second);
+        return it->second;
+      }
+
+      std::vector< Step > steps_;
+      std::map< Key, std::size_t > index_;
+      std::unordered_map< const ExpressionNode*, std::size_t > visited_;
+      std::size_t root_;
+    };
+
+    /// A step's result: a leaf's ciphertext read in place, or a temporary
+    struct Value {
+      const seal::Ciphertext* borrowed {nullptr};
+      seal::Ciphertext owned;
+
+      [[nodiscard]] auto get() const -> const seal::Ciphertext& {
+        return borrowed != nullptr ? *borrowed : owned;
+      }
+    };
+
+    auto Plan::run(const CryptoContext& ctx) const -> HomomorphicInt {
+      auto& evaluator = ctx.evaluator();
+      const bool relinearize = ctx.hasRelinKeys();
+
+      std::vector< Value > values(steps_.size());
+      std::vector< std::size_t > remaining(steps_.size());
+      for(std::size_t i = 0; i < steps_.size(); ++i) {
+        remaining[i] = steps_[i].uses;
+      }
+
+      // A temporary whose only remaining reads are by the current step can
+      // be overwritten in place instead of allocating a new ciphertext
+      auto dead_after = [&](std::size_t index, std::size_t reads) {
+        return values[index].borrowed == nullptr && remaining[index] == reads;
+      };
+
+      // Products are relinearized only once they are multiplied again (and
+      // at the root), so sums of products share the key switch. A shared
+      // temporary is relinearized in place, which every reader benefits
+      // from; a leaf is relinearized into a temporary.
+      auto relinearizeOperand = [&](std::size_t index) {
+        auto& value = values[index];
+        if(!relinearize || value.get().size() <= 2) {
+          return;
+        }
+        if(value.borrowed != nullptr) {
+          evaluator.relinearize(*value.borrowed, ctx.relinKeys(), value.owned);
+          value.borrowed = nullptr;
+        } else {
+          evaluator.relinearize_inplace(value.owned, ctx.relinKeys());
+        }
+      };
+
+      // The estimate each step's eager operator would carry
+      std::vector< detail::NoiseEstimate > noise(steps_.size());
+      auto estimate = [&](const Step& step) -> detail::NoiseEstimate {
+        switch(step.op) {
+          case ExpressionOp::Leaf:
+            return {step.leaf->depth(), step.leaf->estimatedNoiseBudget()};
+          case ExpressionOp::Negate:
+          case ExpressionOp::AddPlain:
+          case ExpressionOp::SubPlain:
+            return noise[step.lhs];
+          case ExpressionOp::MulPlain:
+            return detail::scaledEstimate(ctx, noise[step.lhs], step.constant);
+          case ExpressionOp::Add:
+          case ExpressionOp::Sub:
+            return detail::sumEstimate(noise[step.lhs], noise[step.rhs]);
+          case ExpressionOp::Mul:
+            return detail::productEstimate(
+                ctx, noise[step.lhs], noise[step.rhs]);
+        }
+        return {};
+      };
+
+      auto release = [&](std::size_t index) {
+        if(--remaining[index] == 0) {
+          values[index].owned = seal::Ciphertext();
+        }
+      };
+
+      for(std::size_t i = 0; i < steps_.size(); ++i) {
+        const auto& step = steps_[i];
+        auto& out = values[i].owned;
+        noise[i] = estimate(step);
+
+        switch(step.op) {
+          case ExpressionOp::Leaf:
+            if(!step.leaf->isValid()) {
+              return {};
+            }
+            values[i].borrowed = &step.leaf->ciphertext();
+            continue;
+
+          case ExpressionOp::Negate:
+            if(dead_after(step.lhs, 1)) {
+              out = std::move(values[step.lhs].owned);
+              evaluator.negate_inplace(out);
+            } else {
+              evaluator.negate(values[step.lhs].get(), out);
+            }
+            break;
+
+          case ExpressionOp::AddPlain:
+          case ExpressionOp::SubPlain:
+          case ExpressionOp::MulPlain: {
+            auto plaintext = ctx.encodeConstant(step.constant);
+            // SEAL rejects multiplying by a zero plaintext (transparent
+            // result)
+            if(step.op == ExpressionOp::MulPlain && plaintext->is_zero()) {
+              return {};
+            }
+            if(dead_after(step.lhs, 1)) {
+              out = std::move(values[step.lhs].owned);
+            } else {
+              out = values[step.lhs].get();
+            }
+            if(step.op == ExpressionOp::AddPlain) {
+              evaluator.add_plain_inplace(out, *plaintext);
+            } else if(step.op == ExpressionOp::SubPlain) {
+              evaluator.sub_plain_inplace(out, *plaintext);
+            } else {
+              evaluator.multiply_plain_inplace(out, *plaintext);
+            }
+            break;
+          }
+
+          case ExpressionOp::Add:
+          case ExpressionOp::Sub:
+          case ExpressionOp::Mul: {
+            const auto a = step.lhs;
+            const auto b = step.rhs;
+            if(step.op == ExpressionOp::Mul) {
+              relinearizeOperand(a);
+              relinearizeOperand(b);
+            }
+
+            if(a == b) {
+              if(dead_after(a, 2)) {
+                out = std::move(values[a].owned);
+              } else {
+                out = values[a].get();
+              }
+              if(step.op == ExpressionOp::Add) {
+                evaluator.add_inplace(out, out);
+              } else if(step.op == ExpressionOp::Sub) {
+                evaluator.sub_inplace(out, out);
+              } else {
+                evaluator.square_inplace(out);
+              }
+            } else if(dead_after(a, 1)) {
+              out = std::move(values[a].owned);
+              if(step.op == ExpressionOp::Add) {
+                evaluator.add_inplace(out, values[b].get());
+              } else if(step.op == ExpressionOp::Sub) {
+                evaluator.sub_inplace(out, values[b].get());
+              } else {
+                evaluator.multiply_inplace(out, values[b].get());
+              }
+            } else if(dead_after(b, 1)) {
+              // a - b == (-b) + a
+              out = std::move(values[b].owned);
+              if(step.op == ExpressionOp::Add) {
+                evaluator.add_inplace(out, values[a].get());
+              } else if(step.op == ExpressionOp::Sub) {
+                evaluator.negate_inplace(out);
+                evaluator.add_inplace(out, values[a].get());
+              } else {
+                evaluator.multiply_inplace(out, values[a].get());
+              }
+            } else if(step.op == ExpressionOp::Add) {
+              evaluator.add(values[a].get(), values[b].get(), out);
+            } else if(step.op == ExpressionOp::Sub) {
+              evaluator.sub(values[a].get(), values[b].get(), out);
+            } else {
+              evaluator.multiply(values[a].get(), values[b].get(), out);
+            }
+            release(b);
+            break;
+          }
+        }
+        release(step.lhs);
+      }
+
+      auto& root = values[root_];
+      if(root.borrowed != nullptr) {
+        root.owned = *root.borrowed; // a bare leaf, the caller gets a copy
+      }
+      if(relinearize && root.owned.size() > 2) {
+        evaluator.relinearize_inplace(root.owned, ctx.relinKeys());
+      }
+      return HomomorphicInt::fromCiphertext(std::move(root.owned),
+                                            ctx,
+                                            noise[root_].depth,
+                                            noise[root_].budget_bits);
+    }
+
+    auto makeNode(ExpressionOp op,
+                  std::shared_ptr< const ExpressionNode > lhs,
+                  std::shared_ptr< const ExpressionNode > rhs = nullptr,
+                  std::int64_t constant = 0)
+        -> std::shared_ptr< const ExpressionNode > {
+      auto node = std::make_shared< ExpressionNode >();
+      node->op = op;
+      node->lhs = std::move(lhs);
+      node->rhs = std::move(rhs);
+      node->constant = constant;
+      return node;
+    }
+
+  } // namespace
+
+  // ==================== Construction ====================
+
+  Expression::Expression(const HomomorphicInt& value) {
+    auto node = std::make_shared< ExpressionNode >();
+    node->leaf = &value;
+    node_ = std::move(node);
+  }
+
+  Expression::Expression(HomomorphicInt&& value) {
+    auto node = std::make_shared< ExpressionNode >();
+    node->owned = std::make_shared< const HomomorphicInt >(std::move(value));
+    node->leaf = node->owned.get();
+    node_ = std::move(node);
+  }
+
+  Expression::Expression(Expression&& other) noexcept : node_(other.node_) {
+  }
+
+  auto Expression::operator=(Expression&& other) noexcept -> Expression& {
+    node_ = other.node_;
+    return *this;
+  }
+
+  Expression::Expression(std::shared_ptr< const ExpressionNode > node) :
+      node_(std::move(node)) {
+  }
+
+  // ==================== Building ====================
+
+  auto operator+(const Expression& lhs, const Expression& rhs) -> Expression {
+    return Expression(makeNode(ExpressionOp::Add, lhs.node_, rhs.node_));
+  }
+
+  auto operator-(const Expression& lhs, const Expression& rhs) -> Expression {
+    return Expression(makeNode(ExpressionOp::Sub, lhs.node_, rhs.node_));
+  }
+
+  auto operator*(const Expression& lhs, const Expression& rhs) -> Expression {
+    return Expression(makeNode(ExpressionOp::Mul, lhs.node_, rhs.node_));
+  }
+
+  auto operator-(const Expression& operand) -> Expression {
+    return Expression(makeNode(ExpressionOp::Negate, operand.node_));
+  }
+
+  auto operator+(const Expression& lhs, std::int64_t rhs) -> Expression {
+    return Expression(
+        makeNode(ExpressionOp::AddPlain, lhs.node_, nullptr, rhs));
+  }
+
+  auto operator-(const Expression& lhs, std::int64_t rhs) -> Expression {
+    return Expression(
+        makeNode(ExpressionOp::SubPlain, lhs.node_, nullptr, rhs));
+  }
+
+  auto operator*(const Expression& lhs, std::int64_t rhs) -> Expression {
+    return Expression(
+        makeNode(ExpressionOp::MulPlain, lhs.node_, nullptr, rhs));
+  }
+
+  auto operator+(std::int64_t lhs, const Expression& rhs) -> Expression {
+    return rhs + lhs;
+  }
+
+  auto operator-(std::int64_t lhs, const Expression& rhs) -> Expression {
+    return -rhs + lhs;
+  }
+
+  auto operator*(std::int64_t lhs, const Expression& rhs) -> Expression {
+    return rhs * lhs;
+  }
+
+  // ==================== Evaluation ====================
+
+  auto Expression::evaluate(const CryptoContext& ctx) const -> HomomorphicInt {
+    if(!ctx.isValid()) {
+      return {};
+    }
+    return Plan(*node_).run(ctx);
+  }
+
+  auto Expression::decrypt(const CryptoContext& ctx, const KeyPair& keys) const
+      -> std::int64_t {
+    return evaluate(ctx).decrypt(ctx, keys);
+  }
+
+  auto Expression::decrypt(const CryptoSession& session) const
+      -> std::int64_t {
+    return evaluate(session.context()).decrypt(session);
+  }
+
+  auto Expression::serialize(const CryptoContext& ctx) const
+      -> std::vector< std::uint8_t > {
+    return evaluate(ctx).serialize(ctx);
+  }
+
+  auto Expression::operationCount() const -> std::size_t {
+    return Plan(*node_).operationCount();
+  }
+
+} // namespace sealcrypt
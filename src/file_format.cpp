@@ -0,0 +1,288 @@
+#include "file_format.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <seal/serialization.h>
+#include <stdexcept>
+
+namespace sealcrypt::detail {
+
+  namespace {
+
+    constexpr std::array< char, 8 > file_magic {
+        'S', 'E', 'A', 'L', 'C', 'R', 'Y', 'P'};
+    constexpr std::uint32_t file_version = 2;
+
+    // magic, version, bits per coefficient, coefficients per chunk,
+    // original size and chunk count
+    constexpr std::uint64_t v1_header_size = 8 + 4 + 4 + 8 + 8 + 8;
+
+    // v1 plus poly modulus degree, plain modulus and parms_id
+    constexpr std::uint64_t v2_fixed_size = v1_header_size + 8 + 8 + 4 * 8;
+
+    // Keeps the bit accumulators below within 64 bits
+    constexpr std::uint32_t max_bits_per_coeff = 32;
+
+    template < typename T > void writeValue(std::ostream& out, T value) {
+      out.write(reinterpret_cast< const char* >(&value), sizeof(value));
+    }
+
+    template < typename T > void readValue(std::istream& in, T& value) {
+      in.read(reinterpret_cast< char* >(&value), sizeof(value));
+    }
+
+    auto readSealHeader(std::istream& in) -> seal::Serialization::SEALHeader {
+      seal::Serialization::SEALHeader header;
+      static_assert(sizeof(header) == seal::Serialization::seal_header_size);
+
+      in.read(reinterpret_cast< char* >(&header), sizeof(header));
+      if(!in || !seal::Serialization::IsValidHeader(header) ||
+         header.size < sizeof(header)) {
+        throw std::runtime_error("Invalid or truncated ciphertext");
+      }
+      return header;
+    }
+
+  } // namespace
+
+  auto sparsePacking() -> Packing {
+    return Packing {8, 1024};
+  }
+
+  auto densePacking(std::size_t poly_modulus_degree,
+                    std::uint64_t plain_modulus) -> Packing {
+    // Largest b with 2^b <= t, so every b-bit field is a valid coefficient
+    std::uint32_t bits = 0;
+    while(bits < 63 && (std::uint64_t {1} << (bits + 1)) <= plain_modulus) {
+      ++bits;
+    }
+    bits = std::min(bits, max_bits_per_coeff);
+
+    // poly_modulus_degree is a power of two >= 1024, so full chunks always
+    // hold a whole number of bytes
+    return Packing {bits, poly_modulus_degree};
+  }
+
+  auto FileHeader::create(const seal::SEALContext& context,
+                          const Packing& packing,
+                          std::uint64_t original_size) -> FileHeader {
+    const auto& parms = context.first_context_data()->parms();
+
+    FileHeader header;
+    header.version = file_version;
+    header.packing = packing;
+    header.original_size = original_size;
+    header.chunk_count = packing.chunkCount(original_size);
+    header.poly_modulus_degree = parms.poly_modulus_degree();
+    header.plain_modulus = parms.plain_modulus().value();
+    header.parms_id = context.first_parms_id();
+    return header;
+  }
+
+  auto FileHeader::size() const -> std::uint64_t {
+    switch(version) {
+    case 0:
+      return 2 * sizeof(std::uint64_t);
+    case 1:
+      return v1_header_size;
+    default:
+      return v2_fixed_size + (chunk_count + 1) * sizeof(std::uint64_t);
+    }
+  }
+
+  auto FileHeader::hasOffsets() const -> bool {
+    return offsets.size() == chunk_count + 1;
+  }
+
+  void writeHeader(const FileHeader& header, std::ostream& out) {
+    out.write(file_magic.data(), file_magic.size());
+    writeValue(out, file_version);
+    writeValue(out, header.packing.bits_per_coeff);
+    writeValue(out, header.packing.coeffs_per_chunk);
+    writeValue(out, header.original_size);
+    writeValue(out, header.chunk_count);
+    writeValue(out, header.poly_modulus_degree);
+    writeValue(out, header.plain_modulus);
+    for(auto word : header.parms_id) {
+      writeValue(out, word);
+    }
+
+    for(std::uint64_t i = 0; i <= header.chunk_count; ++i) {
+      writeValue(out, header.hasOffsets() ? header.offsets[i] : 0);
+    }
+  }
+
+  void writeOffsets(const FileHeader& header,
+                    std::ostream& out,
+                    std::streampos header_pos) {
+    const auto end = out.tellp();
+    out.seekp(header_pos + static_cast< std::streamoff >(v2_fixed_size));
+    for(auto offset : header.offsets) {
+      writeValue(out, offset);
+    }
+    out.seekp(end);
+  }
+
+  auto readHeader(std::istream& in,
+                  const seal::SEALContext& context,
+                  bool load_offsets,
+                  FileHeader& header,
+                  std::string& error) -> bool {
+    header = FileHeader {};
+
+    std::array< char, 8 > magic {};
+    in.read(magic.data(), magic.size());
+    if(!in) {
+      error = "Encrypted data is too short";
+      return false;
+    }
+
+    if(magic != file_magic) {
+      // Legacy layout: the first 8 bytes are the original size
+      header.version = 0;
+      header.packing = sparsePacking();
+      std::memcpy(&header.original_size, magic.data(), magic.size());
+      readValue(in, header.chunk_count);
+    } else {
+      readValue(in, header.version);
+      readValue(in, header.packing.bits_per_coeff);
+      readValue(in, header.packing.coeffs_per_chunk);
+      readValue(in, header.original_size);
+      readValue(in, header.chunk_count);
+
+      if(in && (header.version == 0 || header.version > file_version)) {
+        error = "Unsupported encrypted file version: " +
+                std::to_string(header.version);
+        return false;
+      }
+
+      if(header.version >= 2) {
+        readValue(in, header.poly_modulus_degree);
+        readValue(in, header.plain_modulus);
+        for(auto& word : header.parms_id) {
+          readValue(in, word);
+        }
+      }
+    }
+
+    const auto& packing = header.packing;
+    if(!in || packing.bits_per_coeff == 0 ||
+       packing.bits_per_coeff > max_bits_per_coeff ||
+       packing.coeffs_per_chunk == 0 || packing.chunkBytes() == 0 ||
+       header.chunk_count != packing.chunkCount(header.original_size)) {
+      error = "Invalid encrypted data header";
+      return false;
+    }
+
+    const auto& parms = context.first_context_data()->parms();
+    if(header.version >= 2 &&
+       (header.poly_modulus_degree != parms.poly_modulus_degree() ||
+        header.plain_modulus != parms.plain_modulus().value() ||
+        header.parms_id != context.first_parms_id())) {
+      error = "Encrypted data uses different encryption parameters";
+      return false;
+    }
+
+    if(packing.coeffs_per_chunk > parms.poly_modulus_degree()) {
+      error = "Encrypted data was packed for a larger polynomial degree";
+      return false;
+    }
+
+    if(header.version >= 2) {
+      // Read entry by entry, a corrupt count fails at end of input instead
+      // of allocating a huge table up front
+      std::uint64_t offset = 0;
+      for(std::uint64_t i = 0; i <= header.chunk_count; ++i) {
+        readValue(in, offset);
+        if(!in) {
+          error = "Truncated chunk offset table";
+          return false;
+        }
+        if(load_offsets) {
+          header.offsets.push_back(offset);
+        }
+      }
+
+      if(load_offsets &&
+         (header.offsets.front() != header.size() ||
+          !std::is_sorted(header.offsets.begin(), header.offsets.end()))) {
+        error = "Invalid chunk offset table";
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void readSerialized(std::istream& in, std::string& bytes) {
+    const auto header = readSealHeader(in);
+    bytes.resize(static_cast< std::size_t >(header.size));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    in.read(bytes.data() + sizeof(header),
+            static_cast< std::streamsize >(header.size - sizeof(header)));
+    if(!in) {
+      throw std::runtime_error("Truncated ciphertext");
+    }
+  }
+
+  void skipSerialized(std::istream& in) {
+    const auto header = readSealHeader(in);
+    in.seekg(static_cast< std::streamoff >(header.size - sizeof(header)),
+             std::ios::cur);
+    if(!in) {
+      throw std::runtime_error("Truncated ciphertext");
+    }
+  }
+
+  void packChunk(const std::uint8_t* bytes,
+                 std::size_t length,
+                 const Packing& packing,
+                 seal::Plaintext& plaintext) {
+    const auto bits = packing.bits_per_coeff;
+    const std::uint64_t mask = (std::uint64_t {1} << bits) - 1;
+
+    plaintext.resize((length * 8 + bits - 1) / bits);
+
+    std::uint64_t acc = 0;
+    std::uint32_t acc_bits = 0;
+    std::size_t coeff = 0;
+    for(std::size_t i = 0; i < length; ++i) {
+      acc |= static_cast< std::uint64_t >(bytes[i]) << acc_bits;
+      acc_bits += 8;
+      while(acc_bits >= bits) {
+        plaintext[coeff++] = acc & mask;
+        acc >>= bits;
+        acc_bits -= bits;
+      }
+    }
+    if(acc_bits > 0) {
+      plaintext[coeff] = acc & mask;
+    }
+  }
+
+  void unpackChunk(const seal::Plaintext& plaintext,
+                   const Packing& packing,
+                   std::uint8_t* bytes,
+                   std::size_t length) {
+    const auto bits = packing.bits_per_coeff;
+    const auto coeff_count = plaintext.coeff_count();
+
+    std::uint64_t acc = 0;
+    std::uint32_t acc_bits = 0;
+    std::size_t coeff = 0;
+    for(std::size_t i = 0; i < length; ++i) {
+      // Fields narrower than a byte take several coefficients per byte
+      while(acc_bits < 8) {
+        std::uint64_t value = coeff < coeff_count ? plaintext[coeff] : 0;
+        acc |= value << acc_bits;
+        acc_bits += bits;
+        ++coeff;
+      }
+      bytes[i] = static_cast< std::uint8_t >(acc & 0xFF);
+      acc >>= 8;
+      acc_bits -= 8;
+    }
+  }
+
+} // namespace sealcrypt::detail
@@ -0,0 +1,110 @@
+#pragma once
+
+// Internal helpers shared by Encryptor and Decryptor for the encrypted file
+// layout. Not part of the public API.
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <seal/context.h>
+#include <seal/plaintext.h>
+#include <string>
+#include <vector>
+
+namespace sealcrypt::detail {
+
+  /// How input bytes are laid out in the coefficients of one plaintext.
+  /// The byte stream is cut into bits_per_coeff-wide little-endian fields,
+  /// one per coefficient, coeffs_per_chunk coefficients per ciphertext.
+  struct Packing {
+    std::uint32_t bits_per_coeff = 8;
+    std::uint64_t coeffs_per_chunk = 1024;
+
+    /// Input bytes carried by one full chunk
+    [[nodiscard]] auto chunkBytes() const -> std::size_t {
+      return static_cast< std::size_t >(coeffs_per_chunk * bits_per_coeff / 8);
+    }
+
+    /// Number of chunks needed for size input bytes
+    [[nodiscard]] auto chunkCount(std::size_t size) const -> std::size_t {
+      return (size + chunkBytes() - 1) / chunkBytes();
+    }
+  };
+
+  /// One byte per coefficient in 1024-coefficient chunks (original layout)
+  auto sparsePacking() -> Packing;
+
+  /// Every coefficient of the polynomial, each holding as many bits as
+  /// stay below the plain modulus (16 bits for t = 65537)
+  auto densePacking(std::size_t poly_modulus_degree,
+                    std::uint64_t plain_modulus) -> Packing;
+
+  struct FileHeader {
+    std::uint32_t version = 0; // 0 = legacy headerless layout
+    Packing packing;
+    std::uint64_t original_size = 0;
+    std::uint64_t chunk_count = 0;
+
+    // Version 2 and later: the parameters the data was encrypted under and
+    // the offset of every ciphertext from the start of the container, plus
+    // one trailing entry for the end of the last ciphertext
+    std::uint64_t poly_modulus_degree = 0;
+    std::uint64_t plain_modulus = 0;
+    seal::parms_id_type parms_id {};
+    std::vector< std::uint64_t > offsets;
+
+    /// Header for new data encrypted under context with packing
+    static auto create(const seal::SEALContext& context,
+                       const Packing& packing,
+                       std::uint64_t original_size) -> FileHeader;
+
+    /// Bytes from the start of the container to the first ciphertext
+    [[nodiscard]] auto size() const -> std::uint64_t;
+
+    /// Whether offsets holds a usable chunk offset table
+    [[nodiscard]] auto hasOffsets() const -> bool;
+  };
+
+  /// Layout (version 2): magic "SEALCRYP", u32 version, u32 bits per
+  /// coefficient, u64 coefficients per chunk, u64 original size, u64 chunk
+  /// count, u64 poly modulus degree, u64 plain modulus, 4 x u64 parms_id,
+  /// then chunk_count + 1 u64 offsets. Missing offsets are written as zero
+  /// and filled in later with writeOffsets.
+  void writeHeader(const FileHeader& header, std::ostream& out);
+
+  /// Overwrite the offset table of a header written at header_pos
+  void writeOffsets(const FileHeader& header,
+                    std::ostream& out,
+                    std::streampos header_pos);
+
+  /// Read a header written by writeHeader, also accepting version 1 (no
+  /// parameters or offsets) and the legacy layout (original size and chunk
+  /// count only, sparse packing), and check it against context
+  /// @param load_offsets Keep the offset table, otherwise it is skipped
+  auto readHeader(std::istream& in,
+                  const seal::SEALContext& context,
+                  bool load_offsets,
+                  FileHeader& header,
+                  std::string& error) -> bool;
+
+  /// Read one serialized SEAL object (SEALHeader plus payload) as raw
+  /// bytes without parsing it, so it can be loaded on another thread
+  void readSerialized(std::istream& in, std::string& bytes);
+
+  /// Seek past one serialized SEAL object using only its SEALHeader
+  void skipSerialized(std::istream& in);
+
+  /// Pack length bytes into plaintext (length <= packing.chunkBytes())
+  void packChunk(const std::uint8_t* bytes,
+                 std::size_t length,
+                 const Packing& packing,
+                 seal::Plaintext& plaintext);
+
+  /// Unpack length bytes from a decrypted plaintext. Coefficients past
+  /// plaintext.coeff_count() read as zero, SEAL trims trailing zeros.
+  void unpackChunk(const seal::Plaintext& plaintext,
+                   const Packing& packing,
+                   std::uint8_t* bytes,
+                   std::size_t length);
+
+} // namespace sealcrypt::detail
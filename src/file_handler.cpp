@@ -6,9 +6,8 @@ namespace sealcrypt {
 
   // ==================== Byte Vector Operations ====================
 
-  // TODO: can crash if too large file, implement file streaming? but files can
-  // be too large for homomorphic bc of growth potential. Possibly just limit
-  // filesize to 1GB?
+  // Loads the whole file, meant for keys and other small files. Large inputs
+  // should go through openForReading (Encryptor::encryptFile streams them).
   auto FileHandler::readFile(const std::string& path,
                              std::vector< std::uint8_t >& data,
                              std::string& error) -> bool {
@@ -1,15 +1,22 @@
 #include "sealcrypt/homomorphic.hpp"
 
 #include "sealcrypt/file_handler.hpp"
+#include "noise_model.hpp"
+#include "parallel.hpp"
+#include "power_cache.hpp"
+#include "relin_policy.hpp"
+#include "save_policy.hpp"
+#include "serialization.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <seal/ciphertext.h>
 #include <seal/decryptor.h>
 #include <seal/encryptor.h>
 #include <seal/plaintext.h>
-#include <sstream>
 #include <stdexcept>
+#include <utility>
 
 namespace sealcrypt {
 
@@ -17,21 +24,23 @@ namespace sealcrypt {
 
   namespace {
 
-    auto toHexString(std::int64_t value) -> std::string {
-      auto two_complement = static_cast< std::uint64_t >(value);
-      std::ostringstream oss;
-      oss << std::hex << two_complement;
-      return oss.str();
+    std::atomic< std::uint64_t > ciphertext_allocations {0};
+
+    auto decodeValue(const seal::Plaintext& plaintext) -> std::int64_t {
+      if(plaintext.coeff_count() == 0) {
+        throw std::runtime_error("Decrypted plaintext is empty");
+      }
+      std::uint64_t unsigned_val = plaintext[0];
+      return static_cast< std::int64_t >(unsigned_val);
     }
 
-    auto fromHexString(const std::string& hex) -> std::int64_t {
-      std::uint64_t value = 0;
-      try {
-        value = std::stoull(hex, nullptr, 16);
-      } catch(const std::exception&) {
-        return 0;
+    /// A value in [0, t) moved to [-(t-1)/2, (t-1)/2], as BatchEncoder
+    /// decodes slots
+    auto centerValue(std::int64_t value, std::uint64_t t) -> std::int64_t {
+      if(static_cast< std::uint64_t >(value) > (t - 1) / 2) {
+        return value - static_cast< std::int64_t >(t);
       }
-      return static_cast< std::int64_t >(value);
+      return value;
     }
 
   } // namespace
@@ -41,6 +50,7 @@ namespace sealcrypt {
   struct HomomorphicInt::Impl {
     seal::Ciphertext ciphertext;
     const CryptoContext* ctx {nullptr};
+    detail::NoiseEstimate noise;
     mutable std::string last_error;
     bool valid {false};
   };
@@ -54,29 +64,44 @@ namespace sealcrypt {
 
   HomomorphicInt::HomomorphicInt(const HomomorphicInt& other) :
       impl_(std::make_unique< Impl >()) {
-    impl_->ciphertext = other.impl_->ciphertext;
-    impl_->ctx = other.impl_->ctx;
-    impl_->last_error = other.impl_->last_error;
-    impl_->valid = other.impl_->valid;
+    if(other.impl_) {
+      *impl_ = *other.impl_;
+      ciphertext_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   auto HomomorphicInt::operator=(const HomomorphicInt& other)
       -> HomomorphicInt& {
     if(this != &other) {
-      impl_->ciphertext = other.impl_->ciphertext;
-      impl_->ctx = other.impl_->ctx;
-      impl_->last_error = other.impl_->last_error;
-      impl_->valid = other.impl_->valid;
+      if(!other.impl_) {
+        impl_ = std::make_unique< Impl >();
+        return *this;
+      }
+      if(!impl_) {
+        impl_ = std::make_unique< Impl >();
+      }
+      *impl_ = *other.impl_;
+      ciphertext_allocations.fetch_add(1, std::memory_order_relaxed);
     }
     return *this;
   }
 
+  // moves only hand over the Impl pointer, the ciphertext itself stays put
+  HomomorphicInt::HomomorphicInt(HomomorphicInt&& other) noexcept = default;
+  auto HomomorphicInt::operator=(HomomorphicInt&& other) noexcept
+      -> HomomorphicInt& = default;
+
   HomomorphicInt::HomomorphicInt(seal::Ciphertext ct,
                                  const CryptoContext* ctx) :
       impl_(std::make_unique< Impl >()) {
-    impl_->ciphertext = ct;
+    impl_->ciphertext = std::move(ct);
     impl_->ctx = ctx;
     impl_->valid = true;
+    if(ctx != nullptr) {
+      impl_->noise =
+          detail::assumedEstimate(*ctx, impl_->ciphertext.parms_id());
+    }
+    ciphertext_allocations.fetch_add(1, std::memory_order_relaxed);
   }
 
   // ==================== Encryption / Decryption ====================
@@ -90,12 +115,8 @@ namespace sealcrypt {
 
     try {
       seal::Encryptor encryptor(ctx.sealContext(), keys.publicKey());
-      seal::Plaintext plaintext;
-      plaintext.resize(1);
-      auto unsigned_val = static_cast< std::uint64_t >(value);
-      plaintext[0] = unsigned_val;
       seal::Ciphertext ciphertext;
-      encryptor.encrypt(plaintext, ciphertext);
+      encryptor.encrypt(*ctx.encodeConstant(value), ciphertext);
       return HomomorphicInt(std::move(ciphertext), &ctx);
     } catch(const std::exception& e) {
       HomomorphicInt result;
@@ -106,26 +127,207 @@ namespace sealcrypt {
 
   auto HomomorphicInt::decrypt(const CryptoContext& ctx,
                                const KeyPair& keys) const -> std::int64_t {
-    if(!impl_->valid || !keys.hasSecretKey()) {
+    if(!isValid() || !keys.hasSecretKey()) {
       return {};
     }
     try {
       seal::Decryptor decryptor(ctx.sealContext(), keys.secretKey());
       seal::Plaintext plaintext;
       decryptor.decrypt(impl_->ciphertext, plaintext);
-      if(plaintext.coeff_count() == 0) {
-        throw std::runtime_error("Decrypted plaintext is empty");
-      }
-      std::uint64_t unsigned_val = plaintext[0];
-      return static_cast< std::int64_t >(unsigned_val);
+      return decodeValue(plaintext);
     } catch(const std::exception& e) {
       throw std::runtime_error("Decryption failed: " + std::string(e.what()));
     }
   }
 
+  auto HomomorphicInt::decryptSigned(const CryptoContext& ctx,
+                                     const KeyPair& keys) const
+      -> std::int64_t {
+    return centerValue(decrypt(ctx, keys), ctx.plainModulus());
+  }
+
+  auto HomomorphicInt::encrypt(std::int64_t value,
+                               const CryptoSession& session) -> HomomorphicInt {
+    if(!session.hasEncryptor()) {
+      return {};
+    }
+
+    try {
+      seal::Ciphertext ciphertext;
+      session.encryptor().encrypt(
+          *session.context().encodeConstant(value), ciphertext);
+      return HomomorphicInt(std::move(ciphertext), &session.context());
+    } catch(const std::exception& e) {
+      HomomorphicInt result;
+      result.impl_->last_error = "Encryption failed: " + std::string(e.what());
+      return result;
+    }
+  }
+
+  auto HomomorphicInt::decrypt(const CryptoSession& session) const
+      -> std::int64_t {
+    if(!isValid() || !session.hasDecryptor()) {
+      return {};
+    }
+    try {
+      seal::Plaintext plaintext;
+      session.decryptor().decrypt(impl_->ciphertext, plaintext);
+      return decodeValue(plaintext);
+    } catch(const std::exception& e) {
+      throw std::runtime_error("Decryption failed: " + std::string(e.what()));
+    }
+  }
+
+  auto HomomorphicInt::decryptSigned(const CryptoSession& session) const
+      -> std::int64_t {
+    return centerValue(decrypt(session), session.context().plainModulus());
+  }
+
+  auto HomomorphicInt::encryptMany(const std::int64_t* values,
+                                   std::size_t count,
+                                   HomomorphicInt* out,
+                                   const CryptoContext& ctx,
+                                   const KeyPair& keys,
+                                   std::size_t threads) -> bool {
+    if(!ctx.isValid() || !keys.hasPublicKey()) {
+      return false;
+    }
+
+    std::atomic< bool > ok {true};
+    try {
+      detail::parallelFor(
+          detail::resolveThreadCount(threads),
+          count,
+          [&](std::size_t, std::size_t begin, std::size_t end) {
+            // Per-worker SEAL state, nothing is shared between threads
+            auto pool = seal::MemoryPoolHandle::New();
+            seal::Encryptor encryptor(ctx.sealContext(), keys.publicKey());
+            seal::Plaintext plaintext(pool);
+            for(std::size_t i = begin; i < end; ++i) {
+              auto& target = out[i];
+              if(!target.impl_) {
+                target.impl_ = std::make_unique< Impl >();
+              }
+              try {
+                ctx.encodeConstant(values[i], plaintext);
+                // Encrypt straight into the caller's element, reusing its
+                // buffer when it already holds a ciphertext. Only
+                // temporaries come from the worker pool, the result keeps
+                // the element's own.
+                encryptor.encrypt(plaintext, target.impl_->ciphertext, pool);
+                target.impl_->ctx = &ctx;
+                target.impl_->noise = detail::assumedEstimate(
+                    ctx, target.impl_->ciphertext.parms_id());
+                target.impl_->valid = true;
+                ciphertext_allocations.fetch_add(1, std::memory_order_relaxed);
+              } catch(const std::exception& e) {
+                target.impl_->valid = false;
+                target.impl_->last_error =
+                    "Encryption failed: " + std::string(e.what());
+                ok = false;
+              }
+            }
+          });
+    } catch(const std::exception&) {
+      // a worker could not set up its encryptor
+      return false;
+    }
+    return ok;
+  }
+
+  auto HomomorphicInt::encryptMany(const std::vector< std::int64_t >& values,
+                                   const CryptoContext& ctx,
+                                   const KeyPair& keys,
+                                   std::size_t threads)
+      -> std::vector< HomomorphicInt > {
+    std::vector< HomomorphicInt > result(values.size());
+    encryptMany(
+        values.data(), values.size(), result.data(), ctx, keys, threads);
+    return result;
+  }
+
+  void HomomorphicInt::decryptMany(const HomomorphicInt* values,
+                                   std::size_t count,
+                                   std::int64_t* out,
+                                   const CryptoContext& ctx,
+                                   const KeyPair& keys,
+                                   std::size_t threads) {
+    if(!ctx.isValid() || !keys.hasSecretKey()) {
+      std::fill_n(out, count, 0);
+      return;
+    }
+
+    try {
+      detail::parallelFor(
+          detail::resolveThreadCount(threads),
+          count,
+          [&](std::size_t, std::size_t begin, std::size_t end) {
+            auto pool = seal::MemoryPoolHandle::New();
+            seal::Decryptor decryptor(ctx.sealContext(), keys.secretKey());
+            seal::Plaintext plaintext(pool);
+            for(std::size_t i = begin; i < end; ++i) {
+              if(!values[i].isValid()) {
+                out[i] = 0;
+                continue;
+              }
+              decryptor.decrypt(values[i].impl_->ciphertext, plaintext);
+              out[i] = decodeValue(plaintext);
+            }
+          });
+    } catch(const std::exception& e) {
+      throw std::runtime_error("Decryption failed: " + std::string(e.what()));
+    }
+  }
+
+  auto HomomorphicInt::decryptMany(const std::vector< HomomorphicInt >& values,
+                                   const CryptoContext& ctx,
+                                   const KeyPair& keys,
+                                   std::size_t threads)
+      -> std::vector< std::int64_t > {
+    std::vector< std::int64_t > result(values.size());
+    decryptMany(
+        values.data(), values.size(), result.data(), ctx, keys, threads);
+    return result;
+  }
+
+  auto HomomorphicInt::encryptSymmetric(std::int64_t value,
+                                        const CryptoContext& ctx,
+                                        const KeyPair& keys)
+      -> std::vector< std::uint8_t > {
+    if(!ctx.isValid() || !keys.hasSecretKey()) {
+      return {};
+    }
+
+    try {
+      seal::Encryptor encryptor(ctx.sealContext(), keys.secretKey());
+      return detail::saveToBytes(
+          encryptor.encrypt_symmetric(*ctx.encodeConstant(value)),
+          ctx.sealComprMode());
+    } catch(const std::exception&) {
+      return {};
+    }
+  }
+
+  auto HomomorphicInt::encryptSymmetric(std::int64_t value,
+                                        const CryptoSession& session)
+      -> std::vector< std::uint8_t > {
+    if(!session.hasSymmetricEncryptor()) {
+      return {};
+    }
+
+    try {
+      const auto& ctx = session.context();
+      return detail::saveToBytes(
+          session.encryptor().encrypt_symmetric(*ctx.encodeConstant(value)),
+          ctx.sealComprMode());
+    } catch(const std::exception&) {
+      return {};
+    }
+  }
+
   // ==================== Arithmetic Operators ====================
 
-  auto HomomorphicInt::operator+(const HomomorphicInt& other) const
+  auto HomomorphicInt::operator+(const HomomorphicInt& other) const&
       -> HomomorphicInt {
     if(!this->isValid() || !other.isValid()) {
       return {};
@@ -133,10 +335,42 @@ namespace sealcrypt {
     seal::Ciphertext result;
     this->impl_->ctx->evaluator().add(
         this->ciphertext(), other.ciphertext(), result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    HomomorphicInt sum(std::move(result), this->impl_->ctx);
+    sum.impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
+    return sum;
+  }
+
+  auto HomomorphicInt::operator+(const HomomorphicInt& other) &&
+      -> HomomorphicInt {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    this->impl_->ctx->evaluator().add_inplace(this->impl_->ciphertext,
+                                              other.ciphertext());
+    this->impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
+    return std::move(*this);
+  }
+
+  auto HomomorphicInt::operator+(HomomorphicInt&& other) const&
+      -> HomomorphicInt {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    this->impl_->ctx->evaluator().add_inplace(other.impl_->ciphertext,
+                                              this->ciphertext());
+    other.impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
+    return std::move(other);
+  }
+
+  auto HomomorphicInt::operator+(HomomorphicInt&& other) &&
+      -> HomomorphicInt {
+    return std::move(*this) + static_cast< const HomomorphicInt& >(other);
   }
 
-  auto HomomorphicInt::operator-(const HomomorphicInt& other) const
+  auto HomomorphicInt::operator-(const HomomorphicInt& other) const&
       -> HomomorphicInt {
     if(!this->isValid() || !other.isValid()) {
       return {};
@@ -144,27 +378,113 @@ namespace sealcrypt {
     seal::Ciphertext result;
     this->impl_->ctx->evaluator().sub(
         this->ciphertext(), other.ciphertext(), result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    HomomorphicInt difference(std::move(result), this->impl_->ctx);
+    difference.impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
+    return difference;
+  }
+
+  auto HomomorphicInt::operator-(const HomomorphicInt& other) &&
+      -> HomomorphicInt {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    this->impl_->ctx->evaluator().sub_inplace(this->impl_->ciphertext,
+                                              other.ciphertext());
+    this->impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
+    return std::move(*this);
   }
 
-  auto HomomorphicInt::operator*(const HomomorphicInt& other) const
+  // a - b == (-b) + a, negation is cheap so the temporary on the right can
+  // still absorb the result
+  auto HomomorphicInt::operator-(HomomorphicInt&& other) const&
       -> HomomorphicInt {
     if(!this->isValid() || !other.isValid()) {
       return {};
     }
+    if(&other == this) {
+      return *this - static_cast< const HomomorphicInt& >(other);
+    }
+    auto& evaluator = this->impl_->ctx->evaluator();
+    evaluator.negate_inplace(other.impl_->ciphertext);
+    evaluator.add_inplace(other.impl_->ciphertext, this->ciphertext());
+    other.impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
+    return std::move(other);
+  }
+
+  auto HomomorphicInt::operator-(HomomorphicInt&& other) &&
+      -> HomomorphicInt {
+    return std::move(*this) - static_cast< const HomomorphicInt& >(other);
+  }
+
+  auto HomomorphicInt::operator*(const HomomorphicInt& other) const&
+      -> HomomorphicInt {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    if(&other == this) {
+      return this->square(*this->impl_->ctx);
+    }
+    const auto& ctx = *this->impl_->ctx;
+    seal::Ciphertext lhs_scratch;
+    seal::Ciphertext rhs_scratch;
     seal::Ciphertext result;
-    this->impl_->ctx->evaluator().multiply(
-        this->ciphertext(), other.ciphertext(), result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    ctx.evaluator().multiply(
+        detail::relinearized(ctx, this->ciphertext(), lhs_scratch),
+        detail::relinearized(ctx, other.ciphertext(), rhs_scratch),
+        result);
+    detail::relinearizeProduct(ctx, result);
+    HomomorphicInt product(std::move(result), this->impl_->ctx);
+    product.impl_->noise =
+        detail::productEstimate(ctx, this->impl_->noise, other.impl_->noise);
+    return product;
+  }
+
+  auto HomomorphicInt::operator*(const HomomorphicInt& other) &&
+      -> HomomorphicInt {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    *this *= other;
+    return std::move(*this);
   }
 
-  auto HomomorphicInt::operator-() const -> HomomorphicInt {
+  auto HomomorphicInt::operator*(HomomorphicInt&& other) const&
+      -> HomomorphicInt {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    if(&other == this) {
+      return *this * static_cast< const HomomorphicInt& >(other);
+    }
+    other *= *this;
+    return std::move(other);
+  }
+
+  auto HomomorphicInt::operator*(HomomorphicInt&& other) &&
+      -> HomomorphicInt {
+    return std::move(*this) * static_cast< const HomomorphicInt& >(other);
+  }
+
+  auto HomomorphicInt::operator-() const& -> HomomorphicInt {
     if(!this->isValid()) {
       return {};
     }
     seal::Ciphertext result;
     this->impl_->ctx->evaluator().negate(this->ciphertext(), result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    HomomorphicInt negated(std::move(result), this->impl_->ctx);
+    negated.impl_->noise = this->impl_->noise;
+    return negated;
+  }
+
+  auto HomomorphicInt::operator-() && -> HomomorphicInt {
+    if(!this->isValid()) {
+      return {};
+    }
+    this->impl_->ctx->evaluator().negate_inplace(this->impl_->ciphertext);
+    return std::move(*this);
   }
 
   auto HomomorphicInt::operator+=(const HomomorphicInt& other)
@@ -174,6 +494,8 @@ namespace sealcrypt {
     }
     this->impl_->ctx->evaluator().add_inplace(this->impl_->ciphertext,
                                               other.ciphertext());
+    this->impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
     return *this;
   }
 
@@ -184,6 +506,8 @@ namespace sealcrypt {
     }
     this->impl_->ctx->evaluator().sub_inplace(this->impl_->ciphertext,
                                               other.ciphertext());
+    this->impl_->noise =
+        detail::sumEstimate(this->impl_->noise, other.impl_->noise);
     return *this;
   }
 
@@ -192,78 +516,213 @@ namespace sealcrypt {
     if(!this->isValid() || !other.isValid()) {
       return *this;
     }
-    this->impl_->ctx->evaluator().multiply_inplace(this->impl_->ciphertext,
-                                                   other.ciphertext());
+    const auto& ctx = *this->impl_->ctx;
+    auto& ciphertext = this->impl_->ciphertext;
+    detail::relinearizeIfGrown(ctx, ciphertext);
+    if(&other == this) {
+      // SEAL resizes the destination first, so it cannot alias the operand
+      ctx.evaluator().square_inplace(ciphertext);
+    } else {
+      seal::Ciphertext scratch;
+      ctx.evaluator().multiply_inplace(
+          ciphertext, detail::relinearized(ctx, other.ciphertext(), scratch));
+    }
+    detail::relinearizeProduct(ctx, ciphertext);
+    this->impl_->noise =
+        detail::productEstimate(ctx, this->impl_->noise, other.impl_->noise);
     return *this;
   }
 
   // ==================== Plaintext Operations ====================
+  // Constants come pre-encoded from the context cache. A constant plaintext
+  // has one non-zero coefficient, which SEAL multiplies as a scalar per RNS
+  // limb, so an NTT-form copy would only add ciphertext transforms.
 
   auto HomomorphicInt::addPlain(std::int64_t value,
-                                const CryptoContext& ctx) const
+                                const CryptoContext& ctx) const&
       -> HomomorphicInt {
     if(!ctx.isValid() || !this->isValid()) {
       return {};
     }
-    seal::Plaintext plaintext(toHexString(value));
+    auto plaintext = ctx.encodeConstant(value);
     seal::Ciphertext result;
-    ctx.evaluator().add_plain(ciphertext(), plaintext, result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    ctx.evaluator().add_plain(ciphertext(), *plaintext, result);
+    HomomorphicInt shifted(std::move(result), this->impl_->ctx);
+    shifted.impl_->noise = this->impl_->noise;
+    return shifted;
+  }
+
+  auto HomomorphicInt::addPlain(std::int64_t value,
+                                const CryptoContext& ctx) && -> HomomorphicInt {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    auto plaintext = ctx.encodeConstant(value);
+    ctx.evaluator().add_plain_inplace(this->impl_->ciphertext, *plaintext);
+    return std::move(*this);
   }
 
   auto HomomorphicInt::subPlain(std::int64_t value,
-                                const CryptoContext& ctx) const
+                                const CryptoContext& ctx) const&
       -> HomomorphicInt {
     if(!ctx.isValid() || !this->isValid()) {
       return {};
     }
-    seal::Plaintext plaintext(toHexString(value));
+    auto plaintext = ctx.encodeConstant(value);
     seal::Ciphertext result;
-    ctx.evaluator().sub_plain(ciphertext(), plaintext, result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    ctx.evaluator().sub_plain(ciphertext(), *plaintext, result);
+    HomomorphicInt shifted(std::move(result), this->impl_->ctx);
+    shifted.impl_->noise = this->impl_->noise;
+    return shifted;
+  }
+
+  auto HomomorphicInt::subPlain(std::int64_t value,
+                                const CryptoContext& ctx) && -> HomomorphicInt {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    auto plaintext = ctx.encodeConstant(value);
+    ctx.evaluator().sub_plain_inplace(this->impl_->ciphertext, *plaintext);
+    return std::move(*this);
   }
 
   auto HomomorphicInt::mulPlain(std::int64_t value,
-                                const CryptoContext& ctx) const
+                                const CryptoContext& ctx) const&
       -> HomomorphicInt {
     if(!ctx.isValid() || !this->isValid()) {
       return {};
     }
-    seal::Plaintext plaintext(toHexString(value));
+    // SEAL rejects multiplying by a zero plaintext (transparent result)
+    auto plaintext = ctx.encodeConstant(value);
+    if(plaintext->is_zero()) {
+      HomomorphicInt result;
+      result.impl_->last_error =
+          "mulPlain by zero gives a transparent ciphertext";
+      return result;
+    }
     seal::Ciphertext result;
-    ctx.evaluator().multiply_plain(ciphertext(), plaintext, result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    ctx.evaluator().multiply_plain(ciphertext(), *plaintext, result);
+    HomomorphicInt scaled(std::move(result), this->impl_->ctx);
+    scaled.impl_->noise =
+        detail::scaledEstimate(ctx, this->impl_->noise, value);
+    return scaled;
+  }
+
+  auto HomomorphicInt::mulPlain(std::int64_t value,
+                                const CryptoContext& ctx) && -> HomomorphicInt {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    auto plaintext = ctx.encodeConstant(value);
+    if(plaintext->is_zero()) {
+      HomomorphicInt result;
+      result.impl_->last_error =
+          "mulPlain by zero gives a transparent ciphertext";
+      return result;
+    }
+    ctx.evaluator().multiply_plain_inplace(this->impl_->ciphertext, *plaintext);
+    this->impl_->noise = detail::scaledEstimate(ctx, this->impl_->noise, value);
+    return std::move(*this);
   }
 
   // ==================== Advanced Operations ====================
 
-  auto HomomorphicInt::square(const CryptoContext& ctx) const
+  auto HomomorphicInt::square(const CryptoContext& ctx) const&
       -> HomomorphicInt {
     if(!ctx.isValid() || !this->isValid()) {
       return {};
     }
+    seal::Ciphertext scratch;
     seal::Ciphertext result;
-    this->impl_->ctx->evaluator().square(ciphertext(), result);
-    return HomomorphicInt(result, this->impl_->ctx);
+    ctx.evaluator().square(detail::relinearized(ctx, ciphertext(), scratch),
+                           result);
+    detail::relinearizeProduct(ctx, result);
+    HomomorphicInt squared(std::move(result), this->impl_->ctx);
+    squared.impl_->noise =
+        detail::productEstimate(ctx, this->impl_->noise, this->impl_->noise);
+    return squared;
+  }
+
+  auto HomomorphicInt::square(const CryptoContext& ctx) && -> HomomorphicInt {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    detail::relinearizeIfGrown(ctx, this->impl_->ciphertext);
+    ctx.evaluator().square_inplace(this->impl_->ciphertext);
+    detail::relinearizeProduct(ctx, this->impl_->ciphertext);
+    this->impl_->noise =
+        detail::productEstimate(ctx, this->impl_->noise, this->impl_->noise);
+    return std::move(*this);
   }
 
   auto HomomorphicInt::power(std::uint64_t exponent,
                              const CryptoContext& ctx,
-                             const KeyPair& keys) const -> HomomorphicInt {
+                             const KeyPair& keys,
+                             const PowerOptions& options) const&
+      -> HomomorphicInt {
     if(!ctx.isValid() || !this->isValid()) {
       return {};
     }
-    if(!keys.hasRelinKeys()) {
+    HomomorphicInt result;
+    result.impl_->last_error = detail::checkPower(keys, exponent);
+    if(!result.impl_->last_error.empty()) {
+      return result;
+    }
+    HomomorphicInt power(detail::computePower(ctx,
+                                              keys.relinKeys(),
+                                              this->ciphertext(),
+                                              exponent,
+                                              options),
+                         &ctx);
+    power.impl_->noise = detail::powerEstimate(
+        ctx, this->impl_->noise, detail::powerDepth(exponent),
+        this->ciphertext().parms_id(),
+        power.ciphertext().parms_id());
+    return power;
+  }
+
+  auto HomomorphicInt::power(std::uint64_t exponent,
+                             const CryptoContext& ctx,
+                             const KeyPair& keys,
+                             const PowerOptions& options) &&
+      -> HomomorphicInt {
+    // The product tree keeps every intermediate power, x itself included,
+    // so there is no storage to reuse
+    return std::as_const(*this).power(exponent, ctx, keys, options);
+  }
+
+  auto HomomorphicInt::powers(std::uint64_t count,
+                              const CryptoContext& ctx,
+                              const KeyPair& keys,
+                              const PowerOptions& options) const
+      -> std::vector< HomomorphicInt > {
+    if(!ctx.isValid() || !this->isValid()) {
       return {};
     }
-    seal::Ciphertext result;
-    ctx.evaluator().exponentiate(
-        this->ciphertext(), exponent, keys.relinKeys(), result);
-    return HomomorphicInt(result, &ctx);
+    impl_->last_error = detail::checkPower(keys, count);
+    if(!impl_->last_error.empty()) {
+      return {};
+    }
+    auto ciphertexts = detail::computePowers(
+        ctx, keys.relinKeys(), this->ciphertext(), count, options);
+    std::vector< HomomorphicInt > result;
+    result.reserve(ciphertexts.size());
+    for(auto& ciphertext : ciphertexts) {
+      HomomorphicInt power(std::move(ciphertext), &ctx);
+      power.impl_->noise = detail::powerEstimate(
+          ctx, this->impl_->noise, detail::powerDepth(result.size() + 1),
+          this->ciphertext().parms_id(), power.ciphertext().parms_id());
+      result.push_back(std::move(power));
+    }
+    return result;
+  }
+
+  auto HomomorphicInt::powerDepth(std::uint64_t exponent) -> std::size_t {
+    return detail::powerDepth(exponent);
   }
 
   auto HomomorphicInt::relinearize(const CryptoContext& ctx,
-                                   const KeyPair& keys) const
+                                   const KeyPair& keys) const&
       -> HomomorphicInt {
     if(!this->isValid() || !ctx.isValid()) {
       return {};
@@ -273,23 +732,90 @@ namespace sealcrypt {
     }
     seal::Ciphertext result;
     ctx.evaluator().relinearize(ciphertext(), keys.relinKeys(), result);
-    return HomomorphicInt(result, &ctx);
+    // Products are charged for their relinearization up front
+    HomomorphicInt relinearized(std::move(result), &ctx);
+    relinearized.impl_->noise = this->impl_->noise;
+    return relinearized;
+  }
+
+  auto HomomorphicInt::relinearize(const CryptoContext& ctx,
+                                   const KeyPair& keys) && -> HomomorphicInt {
+    if(!this->isValid() || !ctx.isValid()) {
+      return {};
+    }
+    if(!keys.hasRelinKeys()) {
+      return {};
+    }
+    ctx.evaluator().relinearize_inplace(this->impl_->ciphertext,
+                                        keys.relinKeys());
+    this->impl_->ctx = &ctx;
+    return std::move(*this);
   }
 
-  auto HomomorphicInt::modSwitchToNext(const CryptoContext& ctx) const
+  auto HomomorphicInt::modSwitchToNext(const CryptoContext& ctx) const&
       -> HomomorphicInt {
     if(!this->isValid() || !ctx.isValid()) {
       return {};
     }
     seal::Ciphertext result;
     ctx.evaluator().mod_switch_to_next(this->ciphertext(), result);
-    return HomomorphicInt(result, &ctx);
+    HomomorphicInt switched(std::move(result), &ctx);
+    switched.impl_->noise = detail::switchedEstimate(
+        ctx, this->impl_->noise, this->ciphertext().parms_id(),
+        switched.ciphertext().parms_id());
+    return switched;
+  }
+
+  auto HomomorphicInt::modSwitchToNext(const CryptoContext& ctx) &&
+      -> HomomorphicInt {
+    if(!this->isValid() || !ctx.isValid()) {
+      return {};
+    }
+    const auto from = this->impl_->ciphertext.parms_id();
+    ctx.evaluator().mod_switch_to_next_inplace(this->impl_->ciphertext);
+    this->impl_->noise = detail::switchedEstimate(
+        ctx, this->impl_->noise, from, this->impl_->ciphertext.parms_id());
+    this->impl_->ctx = &ctx;
+    return std::move(*this);
+  }
+
+  auto HomomorphicInt::compact(const CryptoContext& ctx,
+                               std::size_t reserve_depth) const&
+      -> HomomorphicInt {
+    if(!this->isValid() || !ctx.isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    ctx.evaluator().mod_switch_to(
+        this->ciphertext(),
+        detail::compactLevel(ctx, this->ciphertext().parms_id(), reserve_depth),
+        result);
+    HomomorphicInt compacted(std::move(result), &ctx);
+    compacted.impl_->noise = detail::switchedEstimate(
+        ctx, this->impl_->noise, this->ciphertext().parms_id(),
+        compacted.ciphertext().parms_id());
+    return compacted;
+  }
+
+  auto HomomorphicInt::compact(const CryptoContext& ctx,
+                               std::size_t reserve_depth) && -> HomomorphicInt {
+    if(!this->isValid() || !ctx.isValid()) {
+      return {};
+    }
+    auto& ciphertext = this->impl_->ciphertext;
+    const auto from = ciphertext.parms_id();
+    ctx.evaluator().mod_switch_to_inplace(
+        ciphertext, detail::compactLevel(ctx, from, reserve_depth));
+    this->impl_->noise = detail::switchedEstimate(
+        ctx, this->impl_->noise, from, ciphertext.parms_id());
+    this->impl_->ctx = &ctx;
+    return std::move(*this);
   }
 
   // ==================== Utility / Info ====================
 
   auto HomomorphicInt::isValid() const -> bool {
-    return impl_->valid;
+    return impl_ && impl_->valid;
   }
 
   auto HomomorphicInt::noiseBudget(const CryptoContext& ctx,
@@ -301,6 +827,13 @@ namespace sealcrypt {
     return decryptor.invariant_noise_budget(ciphertext());
   }
 
+  auto HomomorphicInt::noiseBudget(const CryptoSession& session) const -> int {
+    if(!this->isValid() || !session.hasDecryptor()) {
+      return {};
+    }
+    return session.decryptor().invariant_noise_budget(ciphertext());
+  }
+
   auto HomomorphicInt::size() const -> std::size_t {
     if(!this->isValid()) {
       return 0;
@@ -310,19 +843,36 @@ namespace sealcrypt {
 
   // transparent encryption means it can be decrypted without secret key
   auto HomomorphicInt::isTransparent() const -> bool {
-    return impl_->ciphertext.is_transparent();
+    return !impl_ || impl_->ciphertext.is_transparent();
   }
 
   auto HomomorphicInt::getLastError() const -> std::string {
-    return impl_->last_error;
+    return impl_ ? impl_->last_error : "Moved-from HomomorphicInt";
+  }
+
+  auto HomomorphicInt::ciphertextAllocations() -> std::uint64_t {
+    return ciphertext_allocations.load(std::memory_order_relaxed);
+  }
+
+  auto HomomorphicInt::estimatedNoiseBudget() const -> int {
+    return isValid() ? impl_->noise.budget_bits : 0;
+  }
+
+  auto HomomorphicInt::depth() const -> std::size_t {
+    return isValid() ? impl_->noise.depth : 0;
+  }
+
+  auto HomomorphicInt::level() const -> std::size_t {
+    if(!isValid() || impl_->ctx == nullptr) {
+      return 0;
+    }
+    return detail::chainIndex(*impl_->ctx, impl_->ciphertext.parms_id());
   }
 
   // ==================== Serialization ====================
 
   auto HomomorphicInt::save(const std::string& path,
                             const CryptoContext& ctx) const -> bool {
-    (void) ctx; // keep ctx arg so api is symmetric for file loads / saves, less
-                // confusing
     if(!this->isValid()) {
       return false;
     }
@@ -330,7 +880,9 @@ namespace sealcrypt {
     if(!fstream) {
       return false;
     }
-    this->impl_->ciphertext.save(*fstream);
+    seal::Ciphertext scratch;
+    detail::preparedForSave(ctx, this->impl_->ciphertext, scratch)
+        .save(*fstream, ctx.sealComprMode());
     return true;
   }
 
@@ -339,38 +891,75 @@ namespace sealcrypt {
     if(!ctx.isValid()) {
       return false;
     }
+    if(!impl_) {
+      impl_ = std::make_unique< Impl >();
+    }
     auto fstream = FileHandler::openForReading(path, this->impl_->last_error);
     if(!fstream) {
       return false;
     }
     impl_->ciphertext.load(ctx.sealContext(), *fstream);
     impl_->ctx = &ctx;
+    impl_->noise = detail::assumedEstimate(ctx, impl_->ciphertext.parms_id());
     impl_->valid = true;
     return true;
   }
 
   auto HomomorphicInt::serialize(const CryptoContext& ctx) const
       -> std::vector< std::uint8_t > {
-    (void)
-        ctx; // keep ctx for deserliaze, i want the args to match for api sake
     if(!this->isValid()) {
       return {};
     }
-    std::ostringstream stream(std::ios::binary);
-    impl_->ciphertext.save(stream);
-    auto str = stream.str();
-    return {str.begin(), str.end()};
+    seal::Ciphertext scratch;
+    return detail::saveToBytes(
+        detail::preparedForSave(ctx, impl_->ciphertext, scratch),
+        ctx.sealComprMode());
   }
 
   auto HomomorphicInt::deserialize(const std::vector< std::uint8_t >& data,
                                    const CryptoContext& ctx) -> bool {
-    if(!ctx.isValid() || data.empty()) {
+    return deserialize(
+        reinterpret_cast< const std::byte* >(data.data()), data.size(), ctx);
+  }
+
+  auto HomomorphicInt::saveSize(const CryptoContext& ctx) const -> std::size_t {
+    if(!this->isValid()) {
+      return 0;
+    }
+    return static_cast< std::size_t >(
+        impl_->ciphertext.save_size(ctx.sealComprMode()));
+  }
+
+  auto HomomorphicInt::serializeTo(std::byte* out,
+                                   std::size_t size,
+                                   const CryptoContext& ctx) const
+      -> std::size_t {
+    if(!this->isValid()) {
+      return 0;
+    }
+    try {
+      seal::Ciphertext scratch;
+      return static_cast< std::size_t >(
+          detail::preparedForSave(ctx, impl_->ciphertext, scratch)
+              .save(out, size, ctx.sealComprMode()));
+    } catch(const std::exception& e) {
+      impl_->last_error = "Serialization failed: " + std::string(e.what());
+      return 0;
+    }
+  }
+
+  auto HomomorphicInt::deserialize(const std::byte* data,
+                                   std::size_t size,
+                                   const CryptoContext& ctx) -> bool {
+    if(!ctx.isValid() || data == nullptr || size == 0) {
       return false;
     }
-    std::string str(data.begin(), data.end());
-    std::istringstream stream(str, std::ios::binary);
-    impl_->ciphertext.load(ctx.sealContext(), stream);
+    if(!impl_) {
+      impl_ = std::make_unique< Impl >();
+    }
+    impl_->ciphertext.load(ctx.sealContext(), data, size);
     impl_->ctx = &ctx;
+    impl_->noise = detail::assumedEstimate(ctx, impl_->ciphertext.parms_id());
     impl_->valid = true;
     return true;
   }
@@ -378,20 +967,38 @@ namespace sealcrypt {
   // ==================== Advanced Access ====================
 
   auto HomomorphicInt::ciphertext() const -> const seal::Ciphertext& {
-    if(!impl_->valid) {
+    if(!isValid()) {
       throw std::runtime_error("No valid ciphertext");
     }
     return impl_->ciphertext;
   }
 
   auto HomomorphicInt::ciphertextMut() -> seal::Ciphertext& {
-    if(!impl_->valid) {
+    if(!isValid()) {
       throw std::runtime_error("No valid ciphertext");
     }
     return impl_->ciphertext;
   }
 
+  auto HomomorphicInt::fromCiphertext(seal::Ciphertext ciphertext,
+                                      const CryptoContext& ctx)
+      -> HomomorphicInt {
+    return HomomorphicInt(std::move(ciphertext), &ctx);
+  }
+
+  auto HomomorphicInt::fromCiphertext(seal::Ciphertext ciphertext,
+                                      const CryptoContext& ctx,
+                                      std::size_t depth,
+                                      int noise_budget) -> HomomorphicInt {
+    HomomorphicInt result(std::move(ciphertext), &ctx);
+    result.impl_->noise = {depth, std::max(noise_budget, 0)};
+    return result;
+  }
+
   void HomomorphicInt::setContext(const CryptoContext* ctx) {
+    if(!impl_) {
+      impl_ = std::make_unique< Impl >();
+    }
     impl_->ctx = ctx;
   }
 
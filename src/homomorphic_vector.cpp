@@ -0,0 +1,770 @@
+#include "sealcrypt/homomorphic_vector.hpp"
+
+#include "sealcrypt/file_handler.hpp"
+#include "sealcrypt/rotation_plan.hpp"
+#include "power_cache.hpp"
+#include "relin_policy.hpp"
+#include "save_policy.hpp"
+#include "serialization.hpp"
+
+#include <exception>
+#include <seal/batchencoder.h>
+#include <seal/ciphertext.h>
+#include <seal/decryptor.h>
+#include <seal/encryptor.h>
+#include <seal/plaintext.h>
+#include <stdexcept>
+
+namespace sealcrypt {
+
+  // ==================== Helper Functions ====================
+
+  namespace {
+
+    auto encodeVector(const std::vector< std::int64_t >& values,
+                      const CryptoContext& ctx) -> seal::Plaintext {
+      const auto& encoder = ctx.batchEncoder();
+      if(values.size() > encoder.slot_count()) {
+        throw std::invalid_argument("Too many values for batching slots");
+      }
+      std::vector< std::int64_t > slots(values);
+      slots.resize(encoder.slot_count(), 0);
+      seal::Plaintext plaintext;
+      encoder.encode(slots, plaintext);
+      return plaintext;
+    }
+
+    /// ct as a rotation needs it: itself, or relinearized into scratch if a
+    /// product left it at three polynomials
+    auto rotatable(const CryptoContext& ctx,
+                   const KeyPair& keys,
+                   const seal::Ciphertext& ct,
+                   seal::Ciphertext& scratch) -> const seal::Ciphertext& {
+      if(ct.size() <= 2) {
+        return ct;
+      }
+      if(!keys.hasRelinKeys()) {
+        throw std::invalid_argument(
+            "ciphertext must be relinearized before rotating");
+      }
+      ctx.evaluator().relinearize(ct, keys.relinKeys(), scratch);
+      return scratch;
+    }
+
+    /// Rotate and add at doubling distances, then add the swapped rows if
+    /// the plan says so. Keys are generated from the same plan.
+    void innerSumInplace(const CryptoContext& ctx,
+                         const KeyPair& keys,
+                         seal::Ciphertext& sum,
+                         std::size_t count = 0) {
+      auto& evaluator = ctx.evaluator();
+      const auto steps = innerSumSteps(ctx, count);
+      const auto& galois_keys = keys.galoisKeysFor(steps);
+      seal::Ciphertext rotated;
+      for(const auto step : steps) {
+        if(step == 0) {
+          evaluator.rotate_columns(sum, galois_keys, rotated);
+        } else {
+          evaluator.rotate_rows(sum, step, galois_keys, rotated);
+        }
+        evaluator.add_inplace(sum, rotated);
+      }
+    }
+
+  } // namespace
+
+  // ==================== Implementation Structure ====================
+
+  struct HomomorphicVector::Impl {
+    seal::Ciphertext ciphertext;
+    const CryptoContext* ctx {nullptr};
+    mutable std::string last_error;
+    bool valid {false};
+  };
+
+  // ==================== Constructors / Destructor ====================
+
+  HomomorphicVector::HomomorphicVector() : impl_(std::make_unique< Impl >()) {
+  }
+
+  HomomorphicVector::~HomomorphicVector() = default;
+
+  HomomorphicVector::HomomorphicVector(const HomomorphicVector& other) :
+      impl_(other.impl_ ? std::make_unique< Impl >(*other.impl_)
+                        : std::make_unique< Impl >()) {
+  }
+
+  auto HomomorphicVector::operator=(const HomomorphicVector& other)
+      -> HomomorphicVector& {
+    if(this != &other) {
+      impl_ = other.impl_ ? std::make_unique< Impl >(*other.impl_)
+                          : std::make_unique< Impl >();
+    }
+    return *this;
+  }
+
+  HomomorphicVector::HomomorphicVector(HomomorphicVector&& other) noexcept =
+      default;
+  auto HomomorphicVector::operator=(HomomorphicVector&& other) noexcept
+      -> HomomorphicVector& = default;
+
+  HomomorphicVector::HomomorphicVector(seal::Ciphertext ct,
+                                       const CryptoContext* ctx) :
+      impl_(std::make_unique< Impl >()) {
+    impl_->ciphertext = std::move(ct);
+    impl_->ctx = ctx;
+    impl_->valid = true;
+  }
+
+  // ==================== Encryption / Decryption ====================
+
+  auto HomomorphicVector::encrypt(const std::vector< std::int64_t >& values,
+                                  const CryptoContext& ctx,
+                                  const KeyPair& keys) -> HomomorphicVector {
+    HomomorphicVector result;
+    if(!ctx.isValid() || !keys.hasPublicKey()) {
+      result.impl_->last_error = "Invalid context or missing public key";
+      return result;
+    }
+    if(!ctx.supportsBatching()) {
+      result.impl_->last_error = "Context does not support batching";
+      return result;
+    }
+
+    try {
+      seal::Encryptor encryptor(ctx.sealContext(), keys.publicKey());
+      auto plaintext = encodeVector(values, ctx);
+      seal::Ciphertext ciphertext;
+      encryptor.encrypt(plaintext, ciphertext);
+      return HomomorphicVector(std::move(ciphertext), &ctx);
+    } catch(const std::exception& e) {
+      result.impl_->last_error = "Encryption failed: " + std::string(e.what());
+      return result;
+    }
+  }
+
+  auto HomomorphicVector::decrypt(const CryptoContext& ctx,
+                                  const KeyPair& keys) const
+      -> std::vector< std::int64_t > {
+    if(!isValid() || !keys.hasSecretKey()) {
+      return {};
+    }
+    try {
+      seal::Decryptor decryptor(ctx.sealContext(), keys.secretKey());
+      seal::Plaintext plaintext;
+      decryptor.decrypt(impl_->ciphertext, plaintext);
+      std::vector< std::int64_t > values;
+      ctx.batchEncoder().decode(plaintext, values);
+      return values;
+    } catch(const std::exception& e) {
+      throw std::runtime_error("Decryption failed: " + std::string(e.what()));
+    }
+  }
+
+  auto HomomorphicVector::encrypt(const std::vector< std::int64_t >& values,
+                                  const CryptoSession& session)
+      -> HomomorphicVector {
+    HomomorphicVector result;
+    if(!session.hasEncryptor()) {
+      result.impl_->last_error = "Session has no encryptor";
+      return result;
+    }
+    if(!session.context().supportsBatching()) {
+      result.impl_->last_error = "Context does not support batching";
+      return result;
+    }
+
+    try {
+      auto plaintext = encodeVector(values, session.context());
+      seal::Ciphertext ciphertext;
+      session.encryptor().encrypt(plaintext, ciphertext);
+      return HomomorphicVector(std::move(ciphertext), &session.context());
+    } catch(const std::exception& e) {
+      result.impl_->last_error = "Encryption failed: " + std::string(e.what());
+      return result;
+    }
+  }
+
+  auto HomomorphicVector::decrypt(const CryptoSession& session) const
+      -> std::vector< std::int64_t > {
+    if(!isValid() || !session.hasDecryptor()) {
+      return {};
+    }
+    try {
+      seal::Plaintext plaintext;
+      session.decryptor().decrypt(impl_->ciphertext, plaintext);
+      std::vector< std::int64_t > values;
+      session.batchEncoder().decode(plaintext, values);
+      return values;
+    } catch(const std::exception& e) {
+      throw std::runtime_error("Decryption failed: " + std::string(e.what()));
+    }
+  }
+
+  // ==================== Arithmetic Operators ====================
+
+  auto HomomorphicVector::operator+(const HomomorphicVector& other) const
+      -> HomomorphicVector {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    this->impl_->ctx->evaluator().add(
+        this->ciphertext(), other.ciphertext(), result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::operator-(const HomomorphicVector& other) const
+      -> HomomorphicVector {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    this->impl_->ctx->evaluator().sub(
+        this->ciphertext(), other.ciphertext(), result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::operator*(const HomomorphicVector& other) const
+      -> HomomorphicVector {
+    if(!this->isValid() || !other.isValid()) {
+      return {};
+    }
+    const auto& ctx = *this->impl_->ctx;
+    seal::Ciphertext lhs_scratch;
+    seal::Ciphertext rhs_scratch;
+    seal::Ciphertext result;
+    ctx.evaluator().multiply(
+        detail::relinearized(ctx, this->ciphertext(), lhs_scratch),
+        detail::relinearized(ctx, other.ciphertext(), rhs_scratch),
+        result);
+    detail::relinearizeProduct(ctx, result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::operator-() const -> HomomorphicVector {
+    if(!this->isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    this->impl_->ctx->evaluator().negate(this->ciphertext(), result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::operator+=(const HomomorphicVector& other)
+      -> HomomorphicVector& {
+    if(!this->isValid() || !other.isValid()) {
+      return *this;
+    }
+    this->impl_->ctx->evaluator().add_inplace(this->impl_->ciphertext,
+                                              other.ciphertext());
+    return *this;
+  }
+
+  auto HomomorphicVector::operator-=(const HomomorphicVector& other)
+      -> HomomorphicVector& {
+    if(!this->isValid() || !other.isValid()) {
+      return *this;
+    }
+    this->impl_->ctx->evaluator().sub_inplace(this->impl_->ciphertext,
+                                              other.ciphertext());
+    return *this;
+  }
+
+  auto HomomorphicVector::operator*=(const HomomorphicVector& other)
+      -> HomomorphicVector& {
+    if(!this->isValid() || !other.isValid()) {
+      return *this;
+    }
+    const auto& ctx = *this->impl_->ctx;
+    auto& ciphertext = this->impl_->ciphertext;
+    detail::relinearizeIfGrown(ctx, ciphertext);
+    if(&other == this) {
+      // SEAL resizes the destination first, so it cannot alias the operand
+      ctx.evaluator().square_inplace(ciphertext);
+    } else {
+      seal::Ciphertext scratch;
+      ctx.evaluator().multiply_inplace(
+          ciphertext, detail::relinearized(ctx, other.ciphertext(), scratch));
+    }
+    detail::relinearizeProduct(ctx, ciphertext);
+    return *this;
+  }
+
+  // ==================== Plaintext Operations ====================
+
+  auto HomomorphicVector::addPlain(std::int64_t value,
+                                   const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    ctx.evaluator().add_plain(ciphertext(), *ctx.encodeConstant(value), result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::addPlain(const std::vector< std::int64_t >& values,
+                                   const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    try {
+      seal::Ciphertext result;
+      ctx.evaluator().add_plain(
+          ciphertext(), encodeVector(values, ctx), result);
+      return HomomorphicVector(std::move(result), this->impl_->ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "addPlain failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  auto HomomorphicVector::subPlain(std::int64_t value,
+                                   const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    ctx.evaluator().sub_plain(ciphertext(), *ctx.encodeConstant(value), result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::subPlain(const std::vector< std::int64_t >& values,
+                                   const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    try {
+      seal::Ciphertext result;
+      ctx.evaluator().sub_plain(
+          ciphertext(), encodeVector(values, ctx), result);
+      return HomomorphicVector(std::move(result), this->impl_->ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "subPlain failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  auto HomomorphicVector::mulPlain(std::int64_t value,
+                                   const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    // SEAL rejects multiplying by a zero plaintext (transparent result)
+    auto plaintext = ctx.encodeConstant(value);
+    if(plaintext->is_zero()) {
+      impl_->last_error = "mulPlain by zero gives a transparent ciphertext";
+      return {};
+    }
+    seal::Ciphertext result;
+    ctx.evaluator().multiply_plain(ciphertext(), *plaintext, result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::mulPlain(const std::vector< std::int64_t >& values,
+                                   const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    try {
+      seal::Ciphertext result;
+      ctx.evaluator().multiply_plain(
+          ciphertext(), encodeVector(values, ctx), result);
+      return HomomorphicVector(std::move(result), this->impl_->ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "mulPlain failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  // ==================== Advanced Operations ====================
+
+  auto HomomorphicVector::square(const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    seal::Ciphertext scratch;
+    seal::Ciphertext result;
+    ctx.evaluator().square(detail::relinearized(ctx, ciphertext(), scratch),
+                           result);
+    detail::relinearizeProduct(ctx, result);
+    return HomomorphicVector(std::move(result), this->impl_->ctx);
+  }
+
+  auto HomomorphicVector::power(std::uint64_t exponent,
+                                const CryptoContext& ctx,
+                                const KeyPair& keys,
+                                const PowerOptions& options) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    HomomorphicVector result;
+    result.impl_->last_error = detail::checkPower(keys, exponent);
+    if(!result.impl_->last_error.empty()) {
+      return result;
+    }
+    return HomomorphicVector(detail::computePower(ctx,
+                                                  keys.relinKeys(),
+                                                  this->ciphertext(),
+                                                  exponent,
+                                                  options),
+                             &ctx);
+  }
+
+  auto HomomorphicVector::powers(std::uint64_t count,
+                                 const CryptoContext& ctx,
+                                 const KeyPair& keys,
+                                 const PowerOptions& options) const
+      -> std::vector< HomomorphicVector > {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    impl_->last_error = detail::checkPower(keys, count);
+    if(!impl_->last_error.empty()) {
+      return {};
+    }
+    auto ciphertexts = detail::computePowers(
+        ctx, keys.relinKeys(), this->ciphertext(), count, options);
+    std::vector< HomomorphicVector > result;
+    result.reserve(ciphertexts.size());
+    for(auto& ciphertext : ciphertexts) {
+      result.push_back(HomomorphicVector(std::move(ciphertext), &ctx));
+    }
+    return result;
+  }
+
+  auto HomomorphicVector::relinearize(const CryptoContext& ctx,
+                                      const KeyPair& keys) const
+      -> HomomorphicVector {
+    if(!this->isValid() || !ctx.isValid()) {
+      return {};
+    }
+    if(!keys.hasRelinKeys()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    ctx.evaluator().relinearize(ciphertext(), keys.relinKeys(), result);
+    return HomomorphicVector(std::move(result), &ctx);
+  }
+
+  auto HomomorphicVector::modSwitchToNext(const CryptoContext& ctx) const
+      -> HomomorphicVector {
+    if(!this->isValid() || !ctx.isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    ctx.evaluator().mod_switch_to_next(this->ciphertext(), result);
+    return HomomorphicVector(std::move(result), &ctx);
+  }
+
+  auto HomomorphicVector::compact(const CryptoContext& ctx,
+                                  std::size_t reserve_depth) const
+      -> HomomorphicVector {
+    if(!this->isValid() || !ctx.isValid()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    ctx.evaluator().mod_switch_to(
+        this->ciphertext(),
+        detail::compactLevel(ctx, this->ciphertext().parms_id(), reserve_depth),
+        result);
+    return HomomorphicVector(std::move(result), &ctx);
+  }
+
+  // ==================== Rotations ====================
+
+  auto HomomorphicVector::rotateRows(int steps,
+                                     const CryptoContext& ctx,
+                                     const KeyPair& keys) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    if(!keys.hasGaloisKeys()) {
+      impl_->last_error = "rotateRows needs Galois keys";
+      return {};
+    }
+    try {
+      seal::Ciphertext scratch;
+      seal::Ciphertext result;
+      ctx.evaluator().rotate_rows(rotatable(ctx, keys, ciphertext(), scratch),
+                                  steps,
+                                  keys.galoisKeysFor({steps}),
+                                  result);
+      return HomomorphicVector(std::move(result), &ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "rotateRows failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  auto HomomorphicVector::rotateColumns(const CryptoContext& ctx,
+                                        const KeyPair& keys) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    if(!keys.hasGaloisKeys()) {
+      impl_->last_error = "rotateColumns needs Galois keys";
+      return {};
+    }
+    try {
+      seal::Ciphertext scratch;
+      seal::Ciphertext result;
+      ctx.evaluator().rotate_columns(
+          rotatable(ctx, keys, ciphertext(), scratch),
+          keys.galoisKeysFor({0}),
+          result);
+      return HomomorphicVector(std::move(result), &ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "rotateColumns failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  auto HomomorphicVector::innerSum(const CryptoContext& ctx,
+                                   const KeyPair& keys,
+                                   std::size_t count) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    if(!keys.hasGaloisKeys()) {
+      impl_->last_error = "innerSum needs Galois keys";
+      return {};
+    }
+    try {
+      seal::Ciphertext scratch;
+      seal::Ciphertext sum = rotatable(ctx, keys, ciphertext(), scratch);
+      innerSumInplace(ctx, keys, sum, count);
+      return HomomorphicVector(std::move(sum), &ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "innerSum failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  auto HomomorphicVector::dot(const HomomorphicVector& other,
+                              const CryptoContext& ctx,
+                              const KeyPair& keys) const -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid() || !other.isValid()) {
+      return {};
+    }
+    if(!keys.hasGaloisKeys() || !keys.hasRelinKeys()) {
+      impl_->last_error = "dot needs relin and Galois keys";
+      return {};
+    }
+    try {
+      auto& evaluator = ctx.evaluator();
+      seal::Ciphertext lhs_scratch;
+      seal::Ciphertext rhs_scratch;
+      seal::Ciphertext product;
+      evaluator.multiply(
+          rotatable(ctx, keys, this->ciphertext(), lhs_scratch),
+          rotatable(ctx, keys, other.ciphertext(), rhs_scratch),
+          product);
+      evaluator.relinearize_inplace(product, keys.relinKeys());
+      innerSumInplace(ctx, keys, product);
+      return HomomorphicVector(std::move(product), &ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "dot failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  auto HomomorphicVector::dotPlain(const std::vector< std::int64_t >& weights,
+                                   const CryptoContext& ctx,
+                                   const KeyPair& keys) const
+      -> HomomorphicVector {
+    if(!ctx.isValid() || !this->isValid()) {
+      return {};
+    }
+    if(!keys.hasGaloisKeys()) {
+      impl_->last_error = "dotPlain needs Galois keys";
+      return {};
+    }
+    try {
+      seal::Ciphertext scratch;
+      seal::Ciphertext product;
+      ctx.evaluator().multiply_plain(
+          rotatable(ctx, keys, ciphertext(), scratch),
+          encodeVector(weights, ctx),
+          product);
+      innerSumInplace(ctx, keys, product);
+      return HomomorphicVector(std::move(product), &ctx);
+    } catch(const std::exception& e) {
+      impl_->last_error = "dotPlain failed: " + std::string(e.what());
+      return {};
+    }
+  }
+
+  // ==================== Utility / Info ====================
+
+  auto HomomorphicVector::isValid() const -> bool {
+    return impl_ && impl_->valid;
+  }
+
+  auto HomomorphicVector::noiseBudget(const CryptoContext& ctx,
+                                      const KeyPair& keys) const -> int {
+    if(!this->isValid() || !ctx.isValid() || !keys.hasSecretKey()) {
+      return {};
+    }
+    seal::Decryptor decryptor(ctx.sealContext(), keys.secretKey());
+    return decryptor.invariant_noise_budget(ciphertext());
+  }
+
+  auto HomomorphicVector::noiseBudget(const CryptoSession& session) const
+      -> int {
+    if(!this->isValid() || !session.hasDecryptor()) {
+      return {};
+    }
+    return session.decryptor().invariant_noise_budget(ciphertext());
+  }
+
+  auto HomomorphicVector::size() const -> std::size_t {
+    if(!this->isValid()) {
+      return 0;
+    }
+    return impl_->ciphertext.size();
+  }
+
+  auto HomomorphicVector::isTransparent() const -> bool {
+    return !impl_ || impl_->ciphertext.is_transparent();
+  }
+
+  auto HomomorphicVector::getLastError() const -> std::string {
+    return impl_ ? impl_->last_error : "Moved-from HomomorphicVector";
+  }
+
+  // ==================== Serialization ====================
+
+  auto HomomorphicVector::save(const std::string& path,
+                               const CryptoContext& ctx) const -> bool {
+    if(!this->isValid()) {
+      return false;
+    }
+    auto fstream = FileHandler::openForWriting(path, this->impl_->last_error);
+    if(!fstream) {
+      return false;
+    }
+    seal::Ciphertext scratch;
+    detail::preparedForSave(ctx, this->impl_->ciphertext, scratch)
+        .save(*fstream, ctx.sealComprMode());
+    return true;
+  }
+
+  auto HomomorphicVector::load(const std::string& path,
+                               const CryptoContext& ctx) -> bool {
+    if(!ctx.isValid()) {
+      return false;
+    }
+    if(!impl_) {
+      impl_ = std::make_unique< Impl >();
+    }
+    auto fstream = FileHandler::openForReading(path, this->impl_->last_error);
+    if(!fstream) {
+      return false;
+    }
+    impl_->ciphertext.load(ctx.sealContext(), *fstream);
+    impl_->ctx = &ctx;
+    impl_->valid = true;
+    return true;
+  }
+
+  auto HomomorphicVector::serialize(const CryptoContext& ctx) const
+      -> std::vector< std::uint8_t > {
+    if(!this->isValid()) {
+      return {};
+    }
+    seal::Ciphertext scratch;
+    return detail::saveToBytes(
+        detail::preparedForSave(ctx, impl_->ciphertext, scratch),
+        ctx.sealComprMode());
+  }
+
+  auto HomomorphicVector::deserialize(const std::vector< std::uint8_t >& data,
+                                      const CryptoContext& ctx) -> bool {
+    return deserialize(
+        reinterpret_cast< const std::byte* >(data.data()), data.size(), ctx);
+  }
+
+  auto HomomorphicVector::saveSize(const CryptoContext& ctx) const
+      -> std::size_t {
+    if(!this->isValid()) {
+      return 0;
+    }
+    return static_cast< std::size_t >(
+        impl_->ciphertext.save_size(ctx.sealComprMode()));
+  }
+
+  auto HomomorphicVector::serializeTo(std::byte* out,
+                                      std::size_t size,
+                                      const CryptoContext& ctx) const
+      -> std::size_t {
+    if(!this->isValid()) {
+      return 0;
+    }
+    try {
+      seal::Ciphertext scratch;
+      return static_cast< std::size_t >(
+          detail::preparedForSave(ctx, impl_->ciphertext, scratch)
+              .save(out, size, ctx.sealComprMode()));
+    } catch(const std::exception& e) {
+      impl_->last_error = "Serialization failed: " + std::string(e.what());
+      return 0;
+    }
+  }
+
+  auto HomomorphicVector::deserialize(const std::byte* data,
+                                      std::size_t size,
+                                      const CryptoContext& ctx) -> bool {
+    if(!ctx.isValid() || data == nullptr || size == 0) {
+      return false;
+    }
+    if(!impl_) {
+      impl_ = std::make_unique< Impl >();
+    }
+    impl_->ciphertext.load(ctx.sealContext(), data, size);
+    impl_->ctx = &ctx;
+    impl_->valid = true;
+    return true;
+  }
+
+  // ==================== Advanced Access ====================
+
+  auto HomomorphicVector::ciphertext() const -> const seal::Ciphertext& {
+    if(!isValid()) {
+      throw std::runtime_error("No valid ciphertext");
+    }
+    return impl_->ciphertext;
+  }
+
+  auto HomomorphicVector::ciphertextMut() -> seal::Ciphertext& {
+    if(!isValid()) {
+      throw std::runtime_error("No valid ciphertext");
+    }
+    return impl_->ciphertext;
+  }
+
+  auto HomomorphicVector::fromCiphertext(seal::Ciphertext ciphertext,
+                                         const CryptoContext& ctx)
+      -> HomomorphicVector {
+    return HomomorphicVector(std::move(ciphertext), &ctx);
+  }
+
+  void HomomorphicVector::setContext(const CryptoContext* ctx) {
+    if(!impl_) {
+      impl_ = std::make_unique< Impl >();
+    }
+    impl_->ctx = ctx;
+  }
+
+} // namespace sealcrypt
@@ -0,0 +1,177 @@
+#include "key_bundle.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace sealcrypt::detail {
+
+  namespace {
+
+    constexpr std::array< char, 8 > bundle_magic {
+        'S', 'E', 'A', 'L', 'K', 'E', 'Y', 'S'};
+    constexpr std::uint32_t bundle_version = 1;
+
+    // magic, version, entry count, poly modulus degree, plain modulus and
+    // parms_id
+    constexpr std::uint64_t fixed_size = 8 + 4 + 4 + 8 + 8 + 4 * 8;
+
+    // key, Galois element, offset and size
+    constexpr std::uint64_t entry_size = 4 + 4 + 8 + 8;
+
+    template < typename T > void writeValue(std::ostream& out, T value) {
+      out.write(reinterpret_cast< const char* >(&value), sizeof(value));
+    }
+
+    /// Bounds-checked reads from the mapped bundle
+    class Reader {
+    public:
+      Reader(const std::uint8_t* data, std::size_t size) :
+          data_(data), size_(size) {
+      }
+
+      template < typename T > auto read(T& value) -> bool {
+        if(size_ - pos_ < sizeof(value)) {
+          return false;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(value));
+        pos_ += sizeof(value);
+        return true;
+      }
+
+    private:
+      const std::uint8_t* data_;
+      std::size_t size_;
+      std::size_t pos_ = 0;
+    };
+
+  } // namespace
+
+  auto BundleHeader::create(const seal::SEALContext& context,
+                            std::vector< BundleEntry > entries)
+      -> BundleHeader {
+    const auto& parms = context.key_context_data()->parms();
+
+    BundleHeader header;
+    header.poly_modulus_degree = parms.poly_modulus_degree();
+    header.plain_modulus = parms.plain_modulus().value();
+    header.parms_id = context.key_parms_id();
+    header.entries = std::move(entries);
+    return header;
+  }
+
+  auto BundleHeader::size() const -> std::uint64_t {
+    return fixed_size + entries.size() * entry_size;
+  }
+
+  void writeBundleHeader(const BundleHeader& header, std::ostream& out) {
+    out.write(bundle_magic.data(), bundle_magic.size());
+    writeValue(out, bundle_version);
+    writeValue(out, static_cast< std::uint32_t >(header.entries.size()));
+    writeValue(out, header.poly_modulus_degree);
+    writeValue(out, header.plain_modulus);
+    for(auto word : header.parms_id) {
+      writeValue(out, word);
+    }
+
+    for(const auto& entry : header.entries) {
+      writeValue(out, static_cast< std::uint32_t >(entry.key));
+      writeValue(out, entry.galois_element);
+      writeValue(out, entry.offset);
+      writeValue(out, entry.size);
+    }
+  }
+
+  auto readBundleHeader(const std::uint8_t* data,
+                        std::size_t size,
+                        const seal::SEALContext& context,
+                        BundleHeader& header,
+                        std::string& error) -> bool {
+    header = BundleHeader {};
+    Reader reader(data, size);
+
+    std::array< char, 8 > magic {};
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    if(!reader.read(magic) || magic != bundle_magic) {
+      error = "Not a key bundle";
+      return false;
+    }
+    if(!reader.read(version) || version == 0 || version > bundle_version) {
+      error = "Unsupported key bundle version: " + std::to_string(version);
+      return false;
+    }
+
+    bool ok = reader.read(count) &&
+              reader.read(header.poly_modulus_degree) &&
+              reader.read(header.plain_modulus);
+    for(auto& word : header.parms_id) {
+      ok = ok && reader.read(word);
+    }
+    if(!ok) {
+      error = "Truncated key bundle header";
+      return false;
+    }
+
+    const auto& parms = context.key_context_data()->parms();
+    if(header.poly_modulus_degree != parms.poly_modulus_degree() ||
+       header.plain_modulus != parms.plain_modulus().value() ||
+       header.parms_id != context.key_parms_id()) {
+      error = "Key bundle uses different encryption parameters";
+      return false;
+    }
+
+    // Read entry by entry, a corrupt count fails at the end of the data
+    // instead of allocating a huge table up front
+    const auto galois_end = 2 * header.poly_modulus_degree;
+    for(std::uint32_t i = 0; i < count; ++i) {
+      BundleEntry entry;
+      std::uint32_t key = 0;
+      if(!reader.read(key) || !reader.read(entry.galois_element) ||
+         !reader.read(entry.offset) || !reader.read(entry.size)) {
+        error = "Truncated key bundle offset table";
+        return false;
+      }
+      entry.key = static_cast< BundleKey >(key);
+
+      const bool galois = entry.key == BundleKey::Galois;
+      if(key > static_cast< std::uint32_t >(BundleKey::Galois) ||
+         (galois && (entry.galois_element % 2 == 0 ||
+                     entry.galois_element >= galois_end)) ||
+         entry.offset > size || entry.size > size - entry.offset) {
+        error = "Invalid key bundle entry " + std::to_string(i);
+        return false;
+      }
+      header.entries.push_back(entry);
+    }
+    return true;
+  }
+
+  auto rotationElement(int step, std::size_t poly_modulus_degree)
+      -> std::uint32_t {
+    // Same as SEAL's GaloisTool::get_elt_from_step: 3^step mod 2n for a
+    // left rotation, 3^(n/2 - |step|) for a right one, 2n - 1 for the swap
+    const std::uint64_t m = 2 * static_cast< std::uint64_t >(
+                                    poly_modulus_degree);
+    const std::uint64_t row_size = poly_modulus_degree / 2;
+    if(step == 0) {
+      return static_cast< std::uint32_t >(m - 1);
+    }
+
+    std::uint64_t exponent = static_cast< std::uint64_t >(std::abs(step));
+    if(exponent >= row_size) {
+      throw std::invalid_argument("step count too large");
+    }
+    if(step < 0) {
+      exponent = row_size - exponent;
+    }
+
+    std::uint64_t element = 1;
+    for(std::uint64_t i = 0; i < exponent; ++i) {
+      element = (element * 3) % m;
+    }
+    return static_cast< std::uint32_t >(element);
+  }
+
+} // namespace sealcrypt::detail
@@ -0,0 +1,65 @@
+#pragma once
+
+// Internal helpers for the single-file key bundle written by
+// KeyPair::saveBundle. Not part of the public API.
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <seal/context.h>
+#include <string>
+#include <vector>
+
+namespace sealcrypt::detail {
+
+  enum class BundleKey : std::uint32_t {
+    Public = 0,
+    Secret = 1,
+    Relin = 2,
+    Galois = 3,
+  };
+
+  /// Where one serialized key sits in the bundle. Galois keys get one entry
+  /// per Galois element, each a GaloisKeys object holding only that key.
+  struct BundleEntry {
+    BundleKey key = BundleKey::Public;
+    std::uint32_t galois_element = 0; // Galois entries only
+    std::uint64_t offset = 0;         // from the start of the bundle
+    std::uint64_t size = 0;
+  };
+
+  struct BundleHeader {
+    std::uint64_t poly_modulus_degree = 0;
+    std::uint64_t plain_modulus = 0;
+    seal::parms_id_type parms_id {};
+    std::vector< BundleEntry > entries;
+
+    /// Header for keys generated under context, offsets still unknown
+    static auto create(const seal::SEALContext& context,
+                       std::vector< BundleEntry > entries) -> BundleHeader;
+
+    /// Bytes from the start of the bundle to the first key
+    [[nodiscard]] auto size() const -> std::uint64_t;
+  };
+
+  /// Layout (version 1): magic "SEALKEYS", u32 version, u32 entry count,
+  /// u64 poly modulus degree, u64 plain modulus, 4 x u64 parms_id (key
+  /// level), then per entry u32 key, u32 Galois element, u64 offset and
+  /// u64 size. The keys follow in SEAL's own serialization.
+  void writeBundleHeader(const BundleHeader& header, std::ostream& out);
+
+  /// Parse a header written by writeBundleHeader from the first size bytes
+  /// of a bundle, check it against context and check that every entry lies
+  /// within the bundle
+  auto readBundleHeader(const std::uint8_t* data,
+                        std::size_t size,
+                        const seal::SEALContext& context,
+                        BundleHeader& header,
+                        std::string& error) -> bool;
+
+  /// Galois element SEAL uses for a row rotation by step, or for swapping
+  /// the rows when step is 0
+  auto rotationElement(int step, std::size_t poly_modulus_degree)
+      -> std::uint32_t;
+
+} // namespace sealcrypt::detail
@@ -1,9 +1,14 @@
 #include "sealcrypt/keys.hpp"
 
 #include "sealcrypt/file_handler.hpp"
+#include "key_bundle.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <seal/galoiskeys.h>
 #include <seal/keygenerator.h>
 #include <seal/publickey.h>
@@ -11,9 +16,133 @@
 #include <seal/secretkey.h>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace sealcrypt {
 
+  namespace {
+
+    /// Galois elements galois_keys holds a key for, to regenerate the same
+    /// set without knowing the steps it was made from
+    auto galoisElements(const seal::GaloisKeys& galois_keys,
+                        std::size_t poly_modulus_degree)
+        -> std::vector< std::uint32_t > {
+      std::vector< std::uint32_t > elements;
+      const auto end = 2 * static_cast< std::uint32_t >(poly_modulus_degree);
+      for(std::uint32_t element = 1; element < end; element += 2) {
+        if(galois_keys.has_key(element)) {
+          elements.push_back(element);
+        }
+      }
+      return elements;
+    }
+
+    /// Distinct Galois elements for steps. Left and right rotations by half
+    /// a row share one.
+    auto stepElements(const std::vector< int >& steps,
+                      std::size_t poly_modulus_degree)
+        -> std::vector< std::uint32_t > {
+      std::vector< std::uint32_t > elements;
+      elements.reserve(steps.size());
+      for(const auto step : steps) {
+        elements.push_back(detail::rotationElement(step, poly_modulus_degree));
+      }
+      std::sort(elements.begin(), elements.end());
+      elements.erase(std::unique(elements.begin(), elements.end()),
+                     elements.end());
+      return elements;
+    }
+
+    /// Steps of SEAL's default Galois key set: every power-of-two row
+    /// rotation both ways plus the row swap
+    auto defaultGaloisSteps(std::size_t poly_modulus_degree)
+        -> std::vector< int > {
+      std::vector< int > steps {0};
+      for(std::size_t step = 1; step < poly_modulus_degree / 2; step *= 2) {
+        steps.push_back(static_cast< int >(step));
+        steps.push_back(-static_cast< int >(step));
+      }
+      return steps;
+    }
+
+    /// Generate relin keys into relin_keys, if not null, and Galois keys for
+    /// the distinct elements into galois_keys, if not null. Each is a
+    /// key-switching key independent of the others, so they are handed out
+    /// to the workers as one list, the relin key first. Every worker runs
+    /// its own KeyGenerator on secret_key and writes its own slots of the
+    /// Galois keys, sized up front as SEAL would.
+    void generateKSwitchKeys(const seal::SEALContext& context,
+                             const seal::SecretKey& secret_key,
+                             std::size_t threads,
+                             seal::RelinKeys* relin_keys,
+                             const std::vector< std::uint32_t >& elements,
+                             seal::GaloisKeys* galois_keys) {
+      const std::size_t first = relin_keys ? 1 : 0;
+      const std::size_t count = first + (galois_keys ? elements.size() : 0);
+      if(galois_keys) {
+        *galois_keys = seal::GaloisKeys();
+        galois_keys->data().resize(
+            context.key_context_data()->parms().poly_modulus_degree());
+        galois_keys->parms_id() = context.key_parms_id();
+      }
+
+      auto work = [&](std::size_t, std::size_t begin, std::size_t end) {
+        seal::KeyGenerator keygen(context, secret_key);
+        if(begin < first) {
+          keygen.create_relin_keys(*relin_keys);
+          begin = first;
+        }
+        if(begin == end) {
+          return;
+        }
+
+        const auto from = static_cast< std::ptrdiff_t >(begin - first);
+        const auto to = static_cast< std::ptrdiff_t >(end - first);
+        seal::GaloisKeys part;
+        keygen.create_galois_keys(
+            std::vector< std::uint32_t >(elements.begin() + from,
+                                         elements.begin() + to),
+            part);
+        for(std::size_t i = begin; i < end; ++i) {
+          const auto index = seal::GaloisKeys::get_index(elements[i - first]);
+          galois_keys->data()[index] = std::move(part.data()[index]);
+        }
+      };
+      detail::parallelFor(threads, count, work);
+    }
+
+    /// A GaloisKeys object holding only the key for element, the unit a key
+    /// bundle stores Galois keys in
+    auto singleGaloisKey(const seal::GaloisKeys& galois_keys,
+                         std::uint32_t element) -> seal::GaloisKeys {
+      const auto index = seal::GaloisKeys::get_index(element);
+      seal::GaloisKeys single;
+      single.parms_id() = galois_keys.parms_id();
+      single.data().resize(index + 1);
+      single.data()[index] = galois_keys.data()[index];
+      return single;
+    }
+
+    template < typename T >
+    auto writeSeeded(const seal::Serializable< T >& key,
+                     const std::string& path,
+                     seal::compr_mode_type compr_mode,
+                     std::string& error) -> bool {
+      auto file = FileHandler::openForWriting(path, error);
+      if(!file) {
+        error = "Failed to open file for writing: " + error;
+        return false;
+      }
+      key.save(*file, compr_mode);
+      if(!*file) {
+        error = "Error writing seeded key to file: " + path;
+        return false;
+      }
+      return true;
+    }
+
+  } // namespace
+
   struct KeyPair::Impl {
     const CryptoContext& ctx;
     std::unique_ptr< seal::KeyGenerator > keygen;
@@ -22,9 +151,133 @@ namespace sealcrypt {
     std::unique_ptr< seal::RelinKeys > relin_keys;
     std::unique_ptr< seal::GaloisKeys > galois_keys;
     mutable std::string last_error;
+    std::size_t threads = 0;
+
+    // Keys from loadBundle() not deserialized yet and the mapped file they
+    // are in. The const accessors load them on first use, under the mutex
+    // since those accessors are called from worker threads.
+    std::unique_ptr< detail::MappedFile > bundle;
+    std::vector< detail::BundleEntry > pending;
+    std::mutex mutex;
 
     explicit Impl(const CryptoContext& context) : ctx(context) {
     }
+
+    auto isPending(detail::BundleKey key) const -> bool {
+      return std::any_of(pending.begin(), pending.end(), [&](const auto& e) {
+        return e.key == key;
+      });
+    }
+
+    /// Forget the bundled key a generate or load just replaced
+    void drop(detail::BundleKey key) {
+      pending.erase(std::remove_if(pending.begin(),
+                                   pending.end(),
+                                   [&](const auto& e) { return e.key == key; }),
+                    pending.end());
+      if(pending.empty()) {
+        bundle.reset();
+      }
+    }
+
+    template < typename T >
+    auto deserialize(const detail::BundleEntry& entry) const -> T {
+      T key;
+      try {
+        key.load(ctx.sealContext(),
+                 reinterpret_cast< const seal::seal_byte* >(bundle->data() +
+                                                            entry.offset),
+                 static_cast< std::size_t >(entry.size));
+      } catch(const std::exception& e) {
+        throw std::runtime_error("Corrupt key bundle entry: " +
+                                 std::string(e.what()));
+      }
+      return key;
+    }
+
+    /// Deserialize the bundled key for slot if it is still pending.
+    /// Caller holds mutex.
+    template < typename T >
+    void resolve(detail::BundleKey key, std::unique_ptr< T >& slot) {
+      auto entry = std::find_if(pending.begin(),
+                                pending.end(),
+                                [&](const auto& e) { return e.key == key; });
+      if(slot || entry == pending.end()) {
+        return;
+      }
+      slot = std::make_unique< T >(deserialize< T >(*entry));
+      drop(key);
+    }
+
+    /// Deserialize the pending Galois keys for elements, or all of them if
+    /// elements is null or one of its keys is in neither place. Keys land
+    /// in slots of galois_keys sized once up front, so references handed
+    /// out earlier stay valid. Caller holds mutex.
+    void resolveGalois(const std::vector< std::uint32_t >* elements) {
+      if(!isPending(detail::BundleKey::Galois)) {
+        return;
+      }
+
+      auto held = [&](std::uint32_t element) {
+        return (galois_keys && galois_keys->has_key(element)) ||
+               std::any_of(pending.begin(), pending.end(), [&](const auto& e) {
+                 return e.key == detail::BundleKey::Galois &&
+                        e.galois_element == element;
+               });
+      };
+      const bool all = elements == nullptr ||
+                       !std::all_of(elements->begin(), elements->end(), held);
+
+      std::vector< detail::BundleEntry > remaining;
+      for(const auto& entry : pending) {
+        const bool wanted =
+            entry.key == detail::BundleKey::Galois &&
+            (all || std::find(elements->begin(),
+                              elements->end(),
+                              entry.galois_element) != elements->end());
+        if(!wanted) {
+          remaining.push_back(entry);
+          continue;
+        }
+
+        auto single = deserialize< seal::GaloisKeys >(entry);
+        const auto index = seal::GaloisKeys::get_index(entry.galois_element);
+        if(index >= single.data().size() || single.data()[index].empty()) {
+          throw std::runtime_error("Key bundle entry lacks its Galois key");
+        }
+        if(!galois_keys) {
+          galois_keys = std::make_unique< seal::GaloisKeys >();
+          galois_keys->parms_id() = single.parms_id();
+          galois_keys->data().resize(ctx.polyModulusDegree());
+        }
+        galois_keys->data()[index] = std::move(single.data()[index]);
+      }
+
+      pending = std::move(remaining);
+      if(pending.empty()) {
+        bundle.reset();
+      }
+    }
+
+    /// The generator for the secret key held: the one generate() made, or
+    /// one rebuilt from a loaded secret key. Null without a secret key.
+    auto generator() -> seal::KeyGenerator* {
+      std::lock_guard< std::mutex > lock(mutex);
+      resolve(detail::BundleKey::Secret, secret_key);
+      if(!keygen && secret_key) {
+        keygen = std::make_unique< seal::KeyGenerator >(ctx.sealContext(),
+                                                        *secret_key);
+      }
+      return keygen.get();
+    }
+
+    /// Deserialize everything still pending. Caller holds mutex.
+    void resolveAll() {
+      resolve(detail::BundleKey::Public, public_key);
+      resolve(detail::BundleKey::Secret, secret_key);
+      resolve(detail::BundleKey::Relin, relin_keys);
+      resolveGalois(nullptr);
+    }
   };
 
   // ==================== Constructors / Destructor ====================
@@ -53,6 +306,8 @@ namespace sealcrypt {
           = std::make_unique< seal::SecretKey >(impl_->keygen->secret_key());
       impl_->public_key = std::make_unique< seal::PublicKey >();
       impl_->keygen->create_public_key(*impl_->public_key);
+      impl_->drop(detail::BundleKey::Public);
+      impl_->drop(detail::BundleKey::Secret);
     } catch(const std::exception& e) {
       impl_->last_error = "Keygen Failed: " + std::string(e.what());
       return false;
@@ -68,12 +323,14 @@ namespace sealcrypt {
   // we want 2 polynomial so we relinearize, making 3 -> 2
   auto KeyPair::generateRelinKeys() -> bool {
     try {
-      if(!impl_->keygen) {
-        impl_->last_error = "Generate Not Called";
+      auto* keygen = impl_->generator();
+      if(!keygen) {
+        impl_->last_error = "No secret key to generate from";
         return false;
       }
       impl_->relin_keys = std::make_unique< seal::RelinKeys >();
-      impl_->keygen->create_relin_keys(*impl_->relin_keys);
+      keygen->create_relin_keys(*impl_->relin_keys);
+      impl_->drop(detail::BundleKey::Relin);
 
     } catch(const std::exception& e) {
       impl_->last_error = "Relin Keygen Failed: " + std::string(e.what());
@@ -82,19 +339,30 @@ namespace sealcrypt {
     return true;
   }
 
-  // when should you use this ?
-  // galois keys are used when trying to calc batched data like a vector
-  // hint hint - grouping of vectors is a matrix
-  // hint hint hint - ML uses matrices ;)
+  // galois keys rotate batched slots: HomomorphicVector::rotateRows(),
+  // rotateColumns(), innerSum() and the dot products built on them
   auto KeyPair::generateGaloisKeys() -> bool {
+    return generateGaloisKeys(
+        defaultGaloisSteps(impl_->ctx.polyModulusDegree()));
+  }
+
+  auto KeyPair::generateGaloisKeys(const std::vector< int >& steps) -> bool {
     try {
-      if(!impl_->keygen) {
-        impl_->last_error = "Generate Not Called";
+      auto* keygen = impl_->generator();
+      if(!keygen) {
+        impl_->last_error = "No secret key to generate from";
         return false;
       }
-      impl_->galois_keys = std::make_unique< seal::GaloisKeys >();
-      impl_->keygen->create_galois_keys(*impl_->galois_keys);
-
+      auto galois_keys = std::make_unique< seal::GaloisKeys >();
+      generateKSwitchKeys(
+          impl_->ctx.sealContext(),
+          keygen->secret_key(),
+          threadCount(),
+          nullptr,
+          stepElements(steps, impl_->ctx.polyModulusDegree()),
+          galois_keys.get());
+      impl_->galois_keys = std::move(galois_keys);
+      impl_->drop(detail::BundleKey::Galois);
     } catch(const std::exception& e) {
       impl_->last_error = "Galois Keygen Failed: " + std::string(e.what());
       return false;
@@ -103,18 +371,51 @@ namespace sealcrypt {
   }
 
   auto KeyPair::generateAll() -> bool {
-    if(!generate()) {
-      return false;
-    }
-    if(!generateRelinKeys()) {
-      return false;
-    }
-    if(!generateGaloisKeys()) {
+    return generate() && generateEvaluationKeys();
+  }
+
+  auto KeyPair::generateEvaluationKeys() -> bool {
+    return generateEvaluationKeys(
+        defaultGaloisSteps(impl_->ctx.polyModulusDegree()));
+  }
+
+  // Relin and Galois keys share one pass over the worker threads
+  auto KeyPair::generateEvaluationKeys(const std::vector< int >& steps)
+      -> bool {
+    try {
+      auto* keygen = impl_->generator();
+      if(!keygen) {
+        impl_->last_error = "No secret key to generate from";
+        return false;
+      }
+      auto relin_keys = std::make_unique< seal::RelinKeys >();
+      auto galois_keys = std::make_unique< seal::GaloisKeys >();
+      generateKSwitchKeys(impl_->ctx.sealContext(),
+                          keygen->secret_key(),
+                          threadCount(),
+                          relin_keys.get(),
+                          stepElements(steps, impl_->ctx.polyModulusDegree()),
+                          galois_keys.get());
+      impl_->relin_keys = std::move(relin_keys);
+      impl_->galois_keys = std::move(galois_keys);
+      impl_->drop(detail::BundleKey::Relin);
+      impl_->drop(detail::BundleKey::Galois);
+    } catch(const std::exception& e) {
+      impl_->last_error
+          = "Evaluation Keygen Failed: " + std::string(e.what());
       return false;
     }
     return true;
   }
 
+  void KeyPair::setThreadCount(std::size_t threads) {
+    impl_->threads = threads;
+  }
+
+  auto KeyPair::threadCount() const -> std::size_t {
+    return detail::resolveThreadCount(impl_->threads);
+  }
+
   // ==================== Save Keys ====================
 
   auto KeyPair::save(const std::string& public_key_path,
@@ -132,7 +433,7 @@ namespace sealcrypt {
     return true;
   }
   auto KeyPair::savePublicKey(const std::string& path) const -> bool {
-    if(!impl_->public_key) {
+    if(!hasPublicKey()) {
       impl_->last_error = "No public key to save";
       return false;
     }
@@ -145,7 +446,7 @@ namespace sealcrypt {
     }
 
     try {
-      impl_->public_key->save(*file);
+      publicKey().save(*file, impl_->ctx.sealComprMode());
       if(!*file) {
         impl_->last_error = "Error writing public key to file: " + path;
         return false;
@@ -159,7 +460,7 @@ namespace sealcrypt {
   }
 
   auto KeyPair::saveSecretKey(const std::string& path) const -> bool {
-    if(!impl_->secret_key) {
+    if(!hasSecretKey()) {
       impl_->last_error = "No secret key to save";
       return false;
     }
@@ -172,7 +473,7 @@ namespace sealcrypt {
     }
 
     try {
-      impl_->secret_key->save(*file);
+      secretKey().save(*file, impl_->ctx.sealComprMode());
       if(!*file) {
         impl_->last_error = "Error writing secret key to file: " + path;
         return false;
@@ -186,7 +487,7 @@ namespace sealcrypt {
   }
 
   auto KeyPair::saveRelinKeys(const std::string& path) const -> bool {
-    if(!impl_->relin_keys) {
+    if(!hasRelinKeys()) {
       impl_->last_error = "No relin keys to save";
       return false;
     }
@@ -199,7 +500,7 @@ namespace sealcrypt {
     }
 
     try {
-      impl_->relin_keys->save(*file);
+      relinKeys().save(*file, impl_->ctx.sealComprMode());
       if(!*file) {
         impl_->last_error = "Error writing relin keys to file: " + path;
         return false;
@@ -213,7 +514,7 @@ namespace sealcrypt {
   }
 
   auto KeyPair::saveGaloisKeys(const std::string& path) const -> bool {
-    if(!impl_->galois_keys) {
+    if(!hasGaloisKeys()) {
       impl_->last_error = "No Galois keys to save";
       return false;
     }
@@ -226,7 +527,7 @@ namespace sealcrypt {
     }
 
     try {
-      impl_->galois_keys->save(*file);
+      galoisKeys().save(*file, impl_->ctx.sealComprMode());
       if(!*file) {
         impl_->last_error = "Error writing Galois keys to file: " + path;
         return false;
@@ -239,6 +540,185 @@ namespace sealcrypt {
     return true;
   }
 
+  // ==================== Seeded Export ====================
+
+  auto KeyPair::exportPublicKey(const std::string& path) const -> bool {
+    try {
+      auto* keygen = impl_->generator();
+      if(!keygen) {
+        impl_->last_error = "No secret key to generate from";
+        return false;
+      }
+      return writeSeeded(keygen->create_public_key(),
+                         path,
+                         impl_->ctx.sealComprMode(),
+                         impl_->last_error);
+    } catch(const std::exception& e) {
+      impl_->last_error
+          = "Exception while exporting public key: " + std::string(e.what());
+      return false;
+    }
+  }
+
+  auto KeyPair::exportEvaluationKeys(const std::string& relin_path,
+                                     const std::string& galois_path) const
+      -> bool {
+    if(!relin_path.empty() && !hasRelinKeys()) {
+      impl_->last_error = "No relin keys to export";
+      return false;
+    }
+    if(!galois_path.empty() && !hasGaloisKeys()) {
+      impl_->last_error = "No Galois keys to export";
+      return false;
+    }
+
+    try {
+      auto* keygen = impl_->generator();
+      if(!keygen) {
+        impl_->last_error = "No secret key to generate from";
+        return false;
+      }
+      const auto compr_mode = impl_->ctx.sealComprMode();
+      if(!relin_path.empty() &&
+         !writeSeeded(keygen->create_relin_keys(),
+                      relin_path,
+                      compr_mode,
+                      impl_->last_error)) {
+        return false;
+      }
+      if(!galois_path.empty() &&
+         !writeSeeded(keygen->create_galois_keys(galoisElements(
+                          galoisKeys(), impl_->ctx.polyModulusDegree())),
+                      galois_path,
+                      compr_mode,
+                      impl_->last_error)) {
+        return false;
+      }
+    } catch(const std::exception& e) {
+      impl_->last_error = "Exception while exporting evaluation keys: " +
+                          std::string(e.what());
+      return false;
+    }
+    return true;
+  }
+
+  // ==================== Key Bundle ====================
+
+  auto KeyPair::saveBundle(const std::string& path) const -> bool {
+    try {
+      // Read whatever a loaded bundle still holds first, so path may also
+      // be the bundle the keys came from
+      std::lock_guard< std::mutex > lock(impl_->mutex);
+      impl_->resolveAll();
+    } catch(const std::exception& e) {
+      impl_->last_error = e.what();
+      return false;
+    }
+
+    std::vector< detail::BundleEntry > entries;
+    if(impl_->public_key) {
+      entries.push_back({detail::BundleKey::Public});
+    }
+    if(impl_->secret_key) {
+      entries.push_back({detail::BundleKey::Secret});
+    }
+    if(impl_->relin_keys) {
+      entries.push_back({detail::BundleKey::Relin});
+    }
+    if(impl_->galois_keys) {
+      for(auto element : galoisElements(*impl_->galois_keys,
+                                        impl_->ctx.polyModulusDegree())) {
+        entries.push_back({detail::BundleKey::Galois, element});
+      }
+    }
+    if(entries.empty()) {
+      impl_->last_error = "No keys to save";
+      return false;
+    }
+
+    std::string error;
+    auto file = FileHandler::openForWriting(path, error);
+    if(!file) {
+      impl_->last_error = "Failed to open file for writing: " + error;
+      return false;
+    }
+
+    try {
+      const auto compr_mode = impl_->ctx.sealComprMode();
+      auto header = detail::BundleHeader::create(impl_->ctx.sealContext(),
+                                                 std::move(entries));
+      // Offsets are zero here and rewritten once the keys are out
+      detail::writeBundleHeader(header, *file);
+      for(auto& entry : header.entries) {
+        entry.offset = static_cast< std::uint64_t >(file->tellp());
+        switch(entry.key) {
+        case detail::BundleKey::Public:
+          impl_->public_key->save(*file, compr_mode);
+          break;
+        case detail::BundleKey::Secret:
+          impl_->secret_key->save(*file, compr_mode);
+          break;
+        case detail::BundleKey::Relin:
+          impl_->relin_keys->save(*file, compr_mode);
+          break;
+        case detail::BundleKey::Galois:
+          singleGaloisKey(*impl_->galois_keys, entry.galois_element)
+              .save(*file, compr_mode);
+          break;
+        }
+        entry.size
+            = static_cast< std::uint64_t >(file->tellp()) - entry.offset;
+      }
+      file->seekp(0);
+      detail::writeBundleHeader(header, *file);
+      if(!*file) {
+        impl_->last_error = "Error writing key bundle to file: " + path;
+        return false;
+      }
+    } catch(const std::exception& e) {
+      impl_->last_error
+          = "Exception while saving key bundle: " + std::string(e.what());
+      return false;
+    }
+    return true;
+  }
+
+  auto KeyPair::loadBundle(const std::string& path) -> bool {
+    if(!impl_->ctx.isValid()) {
+      impl_->last_error = "Invalid context";
+      return false;
+    }
+
+    std::string error;
+    auto bundle = std::make_unique< detail::MappedFile >();
+    if(!bundle->open(path, error)) {
+      impl_->last_error = "Failed to open key bundle for reading: " + error;
+      return false;
+    }
+
+    detail::BundleHeader header;
+    if(!detail::readBundleHeader(bundle->data(),
+                                 bundle->size(),
+                                 impl_->ctx.sealContext(),
+                                 header,
+                                 error)) {
+      impl_->last_error = error + ": " + path;
+      return false;
+    }
+
+    impl_->keygen.reset();
+    impl_->public_key.reset();
+    impl_->secret_key.reset();
+    impl_->relin_keys.reset();
+    impl_->galois_keys.reset();
+    impl_->pending = std::move(header.entries);
+    impl_->bundle = std::move(bundle);
+    if(impl_->pending.empty()) {
+      impl_->bundle.reset();
+    }
+    return true;
+  }
+
   // ==================== Load Keys ====================
 
   auto KeyPair::load(const std::string& public_key_path,
@@ -269,6 +749,7 @@ namespace sealcrypt {
         return false;
       }
       impl_->public_key = std::move(pk);
+      impl_->drop(detail::BundleKey::Public);
     } catch(const std::exception& e) {
       impl_->last_error
           = "Exception while loading public key: " + std::string(e.what());
@@ -299,6 +780,8 @@ namespace sealcrypt {
         return false;
       }
       impl_->secret_key = std::move(sk);
+      impl_->keygen.reset();
+      impl_->drop(detail::BundleKey::Secret);
     } catch(const std::exception& e) {
       impl_->last_error
           = "Exception while loading secret key: " + std::string(e.what());
@@ -329,6 +812,7 @@ namespace sealcrypt {
         return false;
       }
       impl_->relin_keys = std::move(rk);
+      impl_->drop(detail::BundleKey::Relin);
     } catch(const std::exception& e) {
       impl_->last_error
           = "Exception while loading relin keys: " + std::string(e.what());
@@ -359,6 +843,7 @@ namespace sealcrypt {
         return false;
       }
       impl_->galois_keys = std::move(gk);
+      impl_->drop(detail::BundleKey::Galois);
     } catch(const std::exception& e) {
       impl_->last_error
           = "Exception while loading Galois keys: " + std::string(e.what());
@@ -370,24 +855,34 @@ namespace sealcrypt {
   // ==================== Key Availability Checks ====================
 
   auto KeyPair::hasPublicKey() const -> bool {
-    return impl_->public_key != nullptr;
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    return impl_->public_key != nullptr ||
+           impl_->isPending(detail::BundleKey::Public);
   }
 
   auto KeyPair::hasSecretKey() const -> bool {
-    return impl_->secret_key != nullptr;
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    return impl_->secret_key != nullptr ||
+           impl_->isPending(detail::BundleKey::Secret);
   }
 
   auto KeyPair::hasRelinKeys() const -> bool {
-    return impl_->relin_keys != nullptr;
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    return impl_->relin_keys != nullptr ||
+           impl_->isPending(detail::BundleKey::Relin);
   }
 
   auto KeyPair::hasGaloisKeys() const -> bool {
-    return impl_->galois_keys != nullptr;
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    return impl_->galois_keys != nullptr ||
+           impl_->isPending(detail::BundleKey::Galois);
   }
 
   // ==================== Key Access ====================
 
   auto KeyPair::publicKey() const -> const seal::PublicKey& {
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    impl_->resolve(detail::BundleKey::Public, impl_->public_key);
     if(!impl_->public_key) {
       throw std::runtime_error("Public key not available");
     }
@@ -395,6 +890,8 @@ namespace sealcrypt {
   }
 
   auto KeyPair::secretKey() const -> const seal::SecretKey& {
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    impl_->resolve(detail::BundleKey::Secret, impl_->secret_key);
     if(!impl_->secret_key) {
       throw std::runtime_error("Secret key not available");
     }
@@ -402,6 +899,8 @@ namespace sealcrypt {
   }
 
   auto KeyPair::relinKeys() const -> const seal::RelinKeys& {
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    impl_->resolve(detail::BundleKey::Relin, impl_->relin_keys);
     if(!impl_->relin_keys) {
       throw std::runtime_error("Relin keys not available");
     }
@@ -409,6 +908,25 @@ namespace sealcrypt {
   }
 
   auto KeyPair::galoisKeys() const -> const seal::GaloisKeys& {
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    impl_->resolveGalois(nullptr);
+    if(!impl_->galois_keys) {
+      throw std::runtime_error("Galois keys not available");
+    }
+    return *impl_->galois_keys;
+  }
+
+  auto KeyPair::galoisKeysFor(const std::vector< int >& steps) const
+      -> const seal::GaloisKeys& {
+    std::vector< std::uint32_t > elements;
+    elements.reserve(steps.size());
+    for(const auto step : steps) {
+      elements.push_back(
+          detail::rotationElement(step, impl_->ctx.polyModulusDegree()));
+    }
+
+    std::lock_guard< std::mutex > lock(impl_->mutex);
+    impl_->resolveGalois(&elements);
     if(!impl_->galois_keys) {
       throw std::runtime_error("Galois keys not available");
     }
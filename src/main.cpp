@@ -13,6 +13,8 @@ void printUsage(const char* program) {
             << "  " << program
             << " encrypt --input <file> --output <file> --public-key <key>\n"
             << "  " << program
+            << " encrypt --input <file> --output <file> --private-key <key>\n"
+            << "  " << program
             << " decrypt --input <file> --output <file> --private-key <key>\n"
             << "\n"
             << "Examples:\n"
@@ -22,6 +24,9 @@ void printUsage(const char* program) {
             << " encrypt --input secret.txt --output secret.enc --public-key "
                "pub.key\n"
             << "  " << program
+            << " encrypt --input secret.txt --output secret.enc --private-key "
+               "priv.key   (symmetric, about half the size)\n"
+            << "  " << program
             << " decrypt --input secret.enc --output decrypted.txt "
                "--private-key priv.key\n";
 }
@@ -90,10 +95,12 @@ auto cmdEncrypt(const std::vector< std::string >& args) -> int {
   std::string input_path = findArg(args, "--input");
   std::string output_path = findArg(args, "--output");
   std::string public_key_path = findArg(args, "--public-key");
+  std::string private_key_path = findArg(args, "--private-key");
 
-  if(input_path.empty() || output_path.empty() || public_key_path.empty()) {
-    std::cerr << "Error: encrypt requires --input, --output, and --public-key "
-                 "arguments\n";
+  if(input_path.empty() || output_path.empty() ||
+     public_key_path.empty() == private_key_path.empty()) {
+    std::cerr << "Error: encrypt requires --input, --output, and either "
+                 "--public-key or --private-key\n";
     return 1;
   }
 
@@ -104,15 +111,23 @@ auto cmdEncrypt(const std::vector< std::string >& args) -> int {
     return 1;
   }
 
-  // Load public key
+  // With the private key, encrypt symmetrically: ciphertexts are stored
+  // seeded and take about half the space
   sealcrypt::KeyPair keys(ctx);
-  if(!keys.loadPublicKey(public_key_path)) {
+  sealcrypt::Encryptor encryptor(ctx);
+  bool loaded = false;
+  if(private_key_path.empty()) {
+    loaded = keys.loadPublicKey(public_key_path);
+  } else {
+    loaded = keys.loadSecretKey(private_key_path);
+    encryptor.setEncryptionMode(sealcrypt::EncryptionMode::Symmetric);
+  }
+  if(!loaded) {
     std::cerr << "Error: " << keys.getLastError() << "\n";
     return 1;
   }
 
   // Encrypt file
-  sealcrypt::Encryptor encryptor(ctx);
   if(!encryptor.encryptFile(input_path, output_path, keys)) {
     std::cerr << "Error: " << encryptor.getLastError() << "\n";
     return 1;
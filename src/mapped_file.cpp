@@ -0,0 +1,90 @@
+#include "mapped_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include "sealcrypt/file_handler.hpp"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sealcrypt::detail {
+
+  MappedFile::~MappedFile() {
+    close();
+  }
+
+#ifdef _WIN32
+
+  auto MappedFile::open(const std::string& path, std::string& error) -> bool {
+    close();
+    if(!FileHandler::readFile(path, buffer_, error)) {
+      return false;
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return true;
+  }
+
+  void MappedFile::close() {
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+#else
+
+  auto MappedFile::open(const std::string& path, std::string& error) -> bool {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+      error = "Cannot open " + path + ": " + std::strerror(errno);
+      return false;
+    }
+
+    struct stat info {};
+    if(::fstat(fd, &info) != 0) {
+      error = "Cannot stat " + path + ": " + std::strerror(errno);
+      ::close(fd);
+      return false;
+    }
+
+    size_ = static_cast< std::size_t >(info.st_size);
+    if(size_ == 0) {
+      // mmap rejects empty files, an empty view is all there is to read
+      ::close(fd);
+      return true;
+    }
+
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if(address == MAP_FAILED) {
+      error = "Cannot map " + path + ": " + std::strerror(errno);
+      size_ = 0;
+      return false;
+    }
+
+    data_ = static_cast< const std::uint8_t* >(address);
+    mapped_ = true;
+    return true;
+  }
+
+  void MappedFile::close() {
+    if(mapped_) {
+      ::munmap(const_cast< std::uint8_t* >(data_), size_);
+    }
+    mapped_ = false;
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+#endif
+
+} // namespace sealcrypt::detail
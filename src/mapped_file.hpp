@@ -0,0 +1,46 @@
+#pragma once
+
+// Read-only view of a whole file, used by the key bundle loader. Not part
+// of the public API.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sealcrypt::detail {
+
+  /// A file mapped into memory with mmap, so pages are only read from disk
+  /// when something touches them. On Windows the file is read into memory
+  /// instead.
+  class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    /// Map path, replacing any previous mapping
+    /// @return false with error set if the file cannot be opened or mapped
+    auto open(const std::string& path, std::string& error) -> bool;
+
+    /// Unmap the file
+    void close();
+
+    [[nodiscard]] auto data() const -> const std::uint8_t* {
+      return data_;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+      return size_;
+    }
+
+  private:
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector< std::uint8_t > buffer_;
+  };
+
+} // namespace sealcrypt::detail
@@ -0,0 +1,187 @@
+#pragma once
+
+// Internal, secret-key-free estimates of BFV noise growth used to pick
+// ciphertext levels. Not part of the public API.
+//
+// BFV mod switching leaves the invariant noise budget alone until the
+// budget exceeds what the smaller modulus can hold, then caps it. So a
+// ciphertext can be switched to any level whose cap still covers the work
+// left, without knowing its actual budget. All figures are in bits and err
+// on the large side.
+//
+// NoiseEstimate goes the other way: it follows one ciphertext through the
+// operators and errs on the small side, so a server can see how much work
+// is left without decrypting.
+
+#include "sealcrypt/context.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace sealcrypt::detail {
+
+  /// Bits left over for rounding error, on top of the per-operation costs
+  constexpr int kNoiseSafetyBits = 10;
+
+  inline auto bitWidth(std::uint64_t value) -> int {
+    int bits = 0;
+    for(; value != 0; value >>= 1) {
+      ++bits;
+    }
+    return bits;
+  }
+
+  /// Budget one relinearized ciphertext-ciphertext multiplication uses:
+  /// the noise grows by about t * n, plus a few bits for relinearization
+  inline auto multiplyCostBits(const CryptoContext& ctx) -> int {
+    return bitWidth(ctx.plainModulus()) +
+           bitWidth(ctx.polyModulusDegree()) + 4;
+  }
+
+  /// Largest noise budget a ciphertext at parms_id can have once mod
+  /// switched there: log2(q) minus the rounding noise of the switch,
+  /// about t * n
+  inline auto levelCapacityBits(const CryptoContext& ctx,
+                                const seal::parms_id_type& parms_id) -> int {
+    auto data = ctx.sealContext().get_context_data(parms_id);
+    if(!data) {
+      return 0;
+    }
+    return data->total_coeff_modulus_bit_count() -
+           2 * bitWidth(ctx.plainModulus()) -
+           bitWidth(ctx.polyModulusDegree());
+  }
+
+  /// Budget a ciphertext needs to survive `multiplications` more
+  /// multiplications and still decrypt
+  inline auto requiredBudgetBits(const CryptoContext& ctx,
+                                 std::size_t multiplications) -> int {
+    return static_cast< int >(multiplications) * multiplyCostBits(ctx) +
+           kNoiseSafetyBits;
+  }
+
+  /// The lowest level at or below parms_id whose capacity still holds
+  /// required_bits, or parms_id itself if no lower level does
+  inline auto lowestLevelFor(const CryptoContext& ctx,
+                             const seal::parms_id_type& parms_id,
+                             int required_bits) -> seal::parms_id_type {
+    auto best = parms_id;
+    auto data = ctx.sealContext().get_context_data(parms_id);
+    for(data = data ? data->next_context_data() : nullptr; data;
+        data = data->next_context_data()) {
+      if(levelCapacityBits(ctx, data->parms_id()) < required_bits) {
+        break;
+      }
+      best = data->parms_id();
+    }
+    return best;
+  }
+
+  /// Level compact() switches a ciphertext at parms_id to: the lowest one
+  /// that still leaves room for reserve_depth multiplications and a
+  /// correct decryption
+  inline auto compactLevel(const CryptoContext& ctx,
+                           const seal::parms_id_type& parms_id,
+                           std::size_t reserve_depth) -> seal::parms_id_type {
+    return lowestLevelFor(
+        ctx, parms_id, requiredBudgetBits(ctx, reserve_depth));
+  }
+
+  /// Chain index of parms_id, higher is a larger modulus
+  inline auto chainIndex(const CryptoContext& ctx,
+                         const seal::parms_id_type& parms_id) -> std::size_t {
+    auto data = ctx.sealContext().get_context_data(parms_id);
+    return data ? data->chain_index() : 0;
+  }
+
+  /// Secret-key-free history a HomomorphicInt carries
+  struct NoiseEstimate {
+    /// Ciphertext-ciphertext multiplications on the longest path
+    std::size_t depth = 0;
+    /// Heuristic lower estimate of the invariant noise budget
+    int budget_bits = 0;
+  };
+
+  /// Budget of a fresh encryption: log2(q / t) minus the encryption
+  /// noise, about n
+  inline auto freshBudgetBits(const CryptoContext& ctx) -> int {
+    auto data = ctx.sealContext().first_context_data();
+    if(!data) {
+      return 0;
+    }
+    return data->total_coeff_modulus_bit_count() -
+           bitWidth(ctx.plainModulus()) - bitWidth(ctx.polyModulusDegree());
+  }
+
+  inline auto spentBits(int budget_bits, int cost_bits) -> int {
+    return std::max(budget_bits - cost_bits, 0);
+  }
+
+  /// Estimate for a ciphertext of unknown history at parms_id, e.g. one
+  /// just loaded: fresh, capped by what its level can hold
+  inline auto assumedEstimate(const CryptoContext& ctx,
+                              const seal::parms_id_type& parms_id)
+      -> NoiseEstimate {
+    auto budget = freshBudgetBits(ctx);
+    if(parms_id != ctx.sealContext().first_parms_id()) {
+      budget = std::min(budget, levelCapacityBits(ctx, parms_id));
+    }
+    return {0, budget};
+  }
+
+  /// a + b, a - b: the noises add up, one bit at most
+  inline auto sumEstimate(const NoiseEstimate& a, const NoiseEstimate& b)
+      -> NoiseEstimate {
+    return {std::max(a.depth, b.depth),
+            spentBits(std::min(a.budget_bits, b.budget_bits), 1)};
+  }
+
+  /// a * b, relinearized
+  inline auto productEstimate(const CryptoContext& ctx,
+                              const NoiseEstimate& a,
+                              const NoiseEstimate& b) -> NoiseEstimate {
+    return {std::max(a.depth, b.depth) + 1,
+            spentBits(std::min(a.budget_bits, b.budget_bits),
+                      multiplyCostBits(ctx))};
+  }
+
+  /// a * value: the noise scales by value, taken mod t and centered
+  inline auto scaledEstimate(const CryptoContext& ctx,
+                             const NoiseEstimate& a,
+                             std::int64_t value) -> NoiseEstimate {
+    const auto t = ctx.plainModulus();
+    auto reduced = static_cast< std::uint64_t >(
+        value % static_cast< std::int64_t >(t) +
+        static_cast< std::int64_t >(t)) % t;
+    return {a.depth,
+            spentBits(a.budget_bits, bitWidth(std::min(reduced, t - reduced)))};
+  }
+
+  /// a after mod switching from one level down to another
+  inline auto switchedEstimate(const CryptoContext& ctx,
+                               const NoiseEstimate& a,
+                               const seal::parms_id_type& from,
+                               const seal::parms_id_type& to)
+      -> NoiseEstimate {
+    if(from == to) {
+      return a;
+    }
+    return {a.depth, std::min(a.budget_bits, levelCapacityBits(ctx, to))};
+  }
+
+  /// A power of a from a product tree tree_depth deep, possibly switched
+  /// down a level on the way
+  inline auto powerEstimate(const CryptoContext& ctx,
+                            const NoiseEstimate& a,
+                            std::size_t tree_depth,
+                            const seal::parms_id_type& from,
+                            const seal::parms_id_type& to) -> NoiseEstimate {
+    NoiseEstimate power {
+        a.depth + tree_depth,
+        spentBits(a.budget_bits,
+                  static_cast< int >(tree_depth) * multiplyCostBits(ctx))};
+    return switchedEstimate(ctx, power, from, to);
+  }
+
+} // namespace sealcrypt::detail
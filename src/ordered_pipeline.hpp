@@ -0,0 +1,166 @@
+#pragma once
+
+// Internal read -> parallel work -> ordered write pipeline used by the file
+// Encryptor and Decryptor. Not part of the public API.
+
+#include "parallel.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sealcrypt::detail {
+
+  /// Run a three-stage pipeline:
+  ///  - read(Job&) -> bool on the calling thread, false at end of input
+  ///  - work(worker_index, Job&) -> Result on one of `workers` threads
+  ///  - write(Result&) on a dedicated writer thread, in read order
+  /// At most 2 * workers jobs are in flight, so memory stays bounded no
+  /// matter how much input there is. The first exception thrown by any
+  /// stage stops the pipeline and is rethrown on the calling thread.
+  template < typename Job,
+             typename Result,
+             typename Read,
+             typename Work,
+             typename Write >
+  void runOrderedPipeline(std::size_t workers,
+                          Read&& read,
+                          Work&& work,
+                          Write&& write) {
+    const std::size_t window = 2 * workers;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque< std::pair< std::size_t, Job > > jobs;
+    std::map< std::size_t, Result > results;
+    std::size_t read_count = 0;
+    std::size_t write_count = 0;
+    bool input_done = false;
+    std::exception_ptr error;
+
+    auto fail = [&](std::exception_ptr e) {
+      std::lock_guard< std::mutex > lock(mutex);
+      if(!error) {
+        error = std::move(e);
+      }
+      changed.notify_all();
+    };
+
+    std::vector< std::thread > threads;
+    threads.reserve(workers + 1);
+
+    auto finish = [&] {
+      {
+        std::lock_guard< std::mutex > lock(mutex);
+        input_done = true;
+        changed.notify_all();
+      }
+      for(auto& thread : threads) {
+        thread.join();
+      }
+    };
+
+    try {
+      for(std::size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w] {
+          for(;;) {
+            std::pair< std::size_t, Job > job;
+            {
+              std::unique_lock< std::mutex > lock(mutex);
+              changed.wait(lock, [&] {
+                return error || input_done || !jobs.empty();
+              });
+              if(error || jobs.empty()) {
+                return;
+              }
+              job = std::move(jobs.front());
+              jobs.pop_front();
+            }
+
+            try {
+              Result result = work(w, job.second);
+              std::lock_guard< std::mutex > lock(mutex);
+              results.emplace(job.first, std::move(result));
+              changed.notify_all();
+            } catch(...) {
+              fail(std::current_exception());
+              return;
+            }
+          }
+        });
+      }
+
+      threads.emplace_back([&] {
+        for(;;) {
+          Result result;
+          {
+            std::unique_lock< std::mutex > lock(mutex);
+            changed.wait(lock, [&] {
+              return error || results.count(write_count) != 0 ||
+                     (input_done && write_count == read_count);
+            });
+            if(error || results.count(write_count) == 0) {
+              return;
+            }
+            auto it = results.find(write_count);
+            result = std::move(it->second);
+            results.erase(it);
+          }
+
+          try {
+            write(result);
+          } catch(...) {
+            fail(std::current_exception());
+            return;
+          }
+
+          std::lock_guard< std::mutex > lock(mutex);
+          ++write_count;
+          changed.notify_all();
+        }
+      });
+    } catch(...) {
+      // Could not start every thread, stop the ones that did
+      fail(std::current_exception());
+      finish();
+      std::rethrow_exception(error);
+    }
+
+    for(;;) {
+      {
+        std::unique_lock< std::mutex > lock(mutex);
+        changed.wait(lock, [&] {
+          return error || read_count - write_count < window;
+        });
+        if(error) {
+          break;
+        }
+      }
+
+      try {
+        Job job;
+        if(!read(job)) {
+          break;
+        }
+        std::lock_guard< std::mutex > lock(mutex);
+        jobs.emplace_back(read_count++, std::move(job));
+        changed.notify_all();
+      } catch(...) {
+        fail(std::current_exception());
+        break;
+      }
+    }
+
+    finish();
+    if(error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+} // namespace sealcrypt::detail
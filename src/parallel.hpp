@@ -0,0 +1,74 @@
+#pragma once
+
+// Internal threading helpers shared by the file pipeline and the batch
+// APIs. Not part of the public API.
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sealcrypt::detail {
+
+  /// Resolve a user thread count, 0 means one per hardware thread
+  inline auto resolveThreadCount(std::size_t threads) -> std::size_t {
+    if(threads == 0) {
+      threads = std::thread::hardware_concurrency();
+    }
+    return std::max< std::size_t >(threads, 1);
+  }
+
+  /// Split [0, count) into one contiguous block per worker and run
+  /// work(worker_index, begin, end) for each block, worker 0 on the calling
+  /// thread. Blocks are equal in size (within one item), which suits work
+  /// whose per-item cost is uniform. The first exception thrown by any
+  /// worker is rethrown once every worker has finished.
+  template < typename Work >
+  void parallelFor(std::size_t workers, std::size_t count, Work&& work) {
+    workers = std::max< std::size_t >(std::min(workers, count), 1);
+    if(workers == 1) {
+      work(std::size_t {0}, std::size_t {0}, count);
+      return;
+    }
+
+    std::mutex mutex;
+    std::exception_ptr error;
+    auto run = [&](std::size_t w) {
+      const std::size_t begin = count * w / workers;
+      const std::size_t end = count * (w + 1) / workers;
+      try {
+        work(w, begin, end);
+      } catch(...) {
+        std::lock_guard< std::mutex > lock(mutex);
+        if(!error) {
+          error = std::current_exception();
+        }
+      }
+    };
+
+    std::vector< std::thread > threads;
+    threads.reserve(workers - 1);
+    try {
+      for(std::size_t w = 1; w < workers; ++w) {
+        threads.emplace_back(run, w);
+      }
+    } catch(...) {
+      // Could not start every thread, let the ones that did finish
+      for(auto& thread : threads) {
+        thread.join();
+      }
+      throw;
+    }
+
+    run(0);
+    for(auto& thread : threads) {
+      thread.join();
+    }
+    if(error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+} // namespace sealcrypt::detail
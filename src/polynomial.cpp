@@ -0,0 +1,310 @@
+#include "sealcrypt/polynomial.hpp"
+
+#include "noise_model.hpp"
+#include "power_cache.hpp"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace sealcrypt {
+
+  namespace {
+
+    using detail::powerDepth;
+
+    /// Whether a coefficient is zero once reduced mod t
+    auto isZero(std::int64_t c, std::uint64_t t) -> bool {
+      return c % static_cast< std::int64_t >(t) == 0;
+    }
+
+    /// Degree of the polynomial once trailing zeros are dropped, 0 for a
+    /// constant
+    auto effectiveDegree(const std::int64_t* coeffs,
+                         std::size_t count,
+                         std::uint64_t t) -> std::size_t {
+      std::size_t size = count;
+      while(size > 0 && isZero(coeffs[size - 1], t)) {
+        --size;
+      }
+      return size > 1 ? size - 1 : 0;
+    }
+
+    /// Exponents x^e needs on top of x: e itself, then its halves
+    void collectPower(std::uint64_t e, std::set< std::uint64_t >& seen) {
+      if(e < 2 || seen.count(e) != 0) {
+        return;
+      }
+      seen.insert(e);
+      const auto [high, low] = detail::powerFactors(e);
+      collectPower(high, seen);
+      collectPower(low, seen);
+    }
+
+    /// Cost of the schedule with baby-step size k, all coefficients non-zero
+    auto scheduleCost(std::size_t degree, std::size_t k) -> PolynomialCost {
+      PolynomialCost cost;
+      cost.baby_steps = k;
+      cost.giant_steps = degree / k + 1;
+
+      std::set< std::uint64_t > powers;
+      for(std::size_t i = 1; i < k && i <= degree; ++i) {
+        collectPower(i, powers);
+        cost.depth = std::max(cost.depth, powerDepth(i));
+      }
+      for(std::size_t j = 1; j < cost.giant_steps; ++j) {
+        collectPower(k * j, powers);
+
+        // The block's baby-step part is multiplied by x^(kj), its constant
+        // term only scaled by it
+        const auto giant_depth = powerDepth(k * j);
+        const auto last = std::min(k - 1, degree - k * j);
+        if(last >= 1) {
+          cost.multiplications += 1;
+          cost.depth = std::max(cost.depth,
+                                std::max(giant_depth, powerDepth(last)) + 1);
+        } else {
+          cost.depth = std::max(cost.depth, giant_depth);
+        }
+      }
+      cost.multiplications += powers.size();
+      return cost;
+    }
+
+    /// Cost of the schedule with baby-step size k for these coefficients,
+    /// counting only the powers and products evaluate() builds for them
+    auto sparseScheduleCost(const std::int64_t* coeffs,
+                            std::size_t degree,
+                            std::size_t k,
+                            std::uint64_t t) -> PolynomialCost {
+      PolynomialCost cost;
+      cost.baby_steps = k;
+      cost.giant_steps = degree / k + 1;
+
+      std::set< std::uint64_t > powers;
+      for(std::size_t start = 0; start <= degree; start += k) {
+        bool has_block = false;
+        std::size_t block_depth = 0;
+        for(std::size_t i = 1; i < k && start + i <= degree; ++i) {
+          if(!isZero(coeffs[start + i], t)) {
+            collectPower(i, powers);
+            block_depth = std::max(block_depth, powerDepth(i));
+            has_block = true;
+          }
+        }
+
+        if(start > 0 && (has_block || !isZero(coeffs[start], t))) {
+          collectPower(start, powers);
+          const auto giant_depth = powerDepth(start);
+          if(has_block) {
+            cost.multiplications += 1;
+            block_depth = std::max(giant_depth, block_depth) + 1;
+          } else {
+            block_depth = giant_depth;
+          }
+        }
+        cost.depth = std::max(cost.depth, block_depth);
+      }
+      cost.multiplications += powers.size();
+      return cost;
+    }
+
+    /// Add c * power to sum, which may still be empty
+    void addScaled(const CryptoContext& ctx,
+                   const seal::Ciphertext& power,
+                   std::int64_t c,
+                   seal::Ciphertext& sum,
+                   bool& has_sum) {
+      auto& evaluator = ctx.evaluator();
+      if(!has_sum) {
+        sum = power;
+        if(c != 1) {
+          evaluator.multiply_plain_inplace(sum, *ctx.encodeConstant(c));
+        }
+        has_sum = true;
+      } else if(c == 1) {
+        evaluator.add_inplace(sum, power);
+      } else {
+        seal::Ciphertext term;
+        evaluator.multiply_plain(power, *ctx.encodeConstant(c), term);
+        evaluator.add_inplace(sum, term);
+      }
+    }
+
+    /// Shared by the HomomorphicInt and HomomorphicVector overloads
+    /// @return false if the polynomial is constant
+    auto evaluate(const seal::Ciphertext& x,
+                  const std::int64_t* coeffs,
+                  std::size_t count,
+                  const CryptoContext& ctx,
+                  const seal::RelinKeys& relin_keys,
+                  seal::Ciphertext& result) -> bool {
+      const auto t = ctx.plainModulus();
+      const auto degree = effectiveDegree(coeffs, count, t);
+      if(degree == 0) {
+        return false;
+      }
+
+      const auto k = polynomialCost(degree).baby_steps;
+      auto& evaluator = ctx.evaluator();
+      detail::PowerCache powers(ctx, relin_keys, x);
+
+      // Products of blocks with their giant step stay at size 3 until the
+      // whole sum is relinearized once
+      bool has_result = false;
+      for(std::size_t start = 0; start <= degree; start += k) {
+        seal::Ciphertext block;
+        bool has_block = false;
+        for(std::size_t i = 1; i < k && start + i <= degree; ++i) {
+          if(!isZero(coeffs[start + i], t)) {
+            addScaled(
+                ctx, powers.get(i), coeffs[start + i], block, has_block);
+          }
+        }
+
+        // A block with nothing to multiply leaves its giant step unbuilt
+        if(start > 0 && (has_block || !isZero(coeffs[start], t))) {
+          const auto& giant = powers.get(start);
+          if(has_block) {
+            evaluator.multiply_inplace(block, giant);
+          }
+          if(!isZero(coeffs[start], t)) {
+            addScaled(ctx, giant, coeffs[start], block, has_block);
+          }
+        }
+        if(!has_block) {
+          continue;
+        }
+
+        if(has_result) {
+          evaluator.add_inplace(result, block);
+        } else {
+          result = std::move(block);
+          has_result = true;
+        }
+      }
+
+      if(!isZero(coeffs[0], t)) {
+        evaluator.add_plain_inplace(result, *ctx.encodeConstant(coeffs[0]));
+      }
+      if(result.size() > 2) {
+        evaluator.relinearize_inplace(result, relin_keys);
+      }
+      return true;
+    }
+
+    /// Estimate for the result: the largest coefficient as a scalar, the
+    /// schedule's depth in full products and a bit per doubling of terms
+    auto resultEstimate(const CryptoContext& ctx,
+                        const detail::NoiseEstimate& x,
+                        const std::int64_t* coeffs,
+                        std::size_t degree) -> detail::NoiseEstimate {
+      auto scaled = x;
+      for(std::size_t i = 0; i <= degree; ++i) {
+        auto term = detail::scaledEstimate(ctx, x, coeffs[i]);
+        if(term.budget_bits < scaled.budget_bits) {
+          scaled = term;
+        }
+      }
+      const auto depth = polynomialCost(degree).depth;
+      return {x.depth + depth,
+              detail::spentBits(
+                  scaled.budget_bits,
+                  static_cast< int >(depth) * detail::multiplyCostBits(ctx) +
+                      detail::bitWidth(degree + 1))};
+    }
+
+  } // namespace
+
+  auto polynomialCost(std::size_t degree) -> PolynomialCost {
+    if(degree == 0) {
+      return {1, 1, 0, 0};
+    }
+
+    PolynomialCost best;
+    bool has_best = false;
+    for(std::size_t k = 1;; k *= 2) {
+      auto cost = scheduleCost(degree, k);
+      if(!has_best || cost.multiplications < best.multiplications ||
+         (cost.multiplications == best.multiplications &&
+          cost.depth < best.depth)) {
+        best = cost;
+        has_best = true;
+      }
+      if(k > degree) {
+        break; // a single block, larger k change nothing
+      }
+    }
+    return best;
+  }
+
+  auto polynomialCost(const std::int64_t* coeffs,
+                      std::size_t count,
+                      const CryptoContext& ctx) -> PolynomialCost {
+    const auto t = ctx.plainModulus();
+    const auto degree = effectiveDegree(coeffs, count, t);
+    if(degree == 0) {
+      return {1, 1, 0, 0};
+    }
+    return sparseScheduleCost(
+        coeffs, degree, polynomialCost(degree).baby_steps, t);
+  }
+
+  auto polynomialCost(const std::vector< std::int64_t >& coeffs,
+                      const CryptoContext& ctx) -> PolynomialCost {
+    return polynomialCost(coeffs.data(), coeffs.size(), ctx);
+  }
+
+  auto evaluatePolynomial(const HomomorphicInt& x,
+                          const std::int64_t* coeffs,
+                          std::size_t count,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicInt {
+    if(!ctx.isValid() || !x.isValid() || !keys.hasRelinKeys()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    if(!evaluate(
+           x.ciphertext(), coeffs, count, ctx, keys.relinKeys(), result)) {
+      return {};
+    }
+    const auto estimate =
+        resultEstimate(ctx,
+                       {x.depth(), x.estimatedNoiseBudget()},
+                       coeffs,
+                       effectiveDegree(coeffs, count, ctx.plainModulus()));
+    return HomomorphicInt::fromCiphertext(
+        std::move(result), ctx, estimate.depth, estimate.budget_bits);
+  }
+
+  auto evaluatePolynomial(const HomomorphicInt& x,
+                          const std::vector< std::int64_t >& coeffs,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicInt {
+    return evaluatePolynomial(x, coeffs.data(), coeffs.size(), ctx, keys);
+  }
+
+  auto evaluatePolynomial(const HomomorphicVector& x,
+                          const std::int64_t* coeffs,
+                          std::size_t count,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicVector {
+    if(!ctx.isValid() || !x.isValid() || !keys.hasRelinKeys()) {
+      return {};
+    }
+    seal::Ciphertext result;
+    if(!evaluate(
+           x.ciphertext(), coeffs, count, ctx, keys.relinKeys(), result)) {
+      return {};
+    }
+    return HomomorphicVector::fromCiphertext(std::move(result), ctx);
+  }
+
+  auto evaluatePolynomial(const HomomorphicVector& x,
+                          const std::vector< std::int64_t >& coeffs,
+                          const CryptoContext& ctx,
+                          const KeyPair& keys) -> HomomorphicVector {
+    return evaluatePolynomial(x, coeffs.data(), coeffs.size(), ctx, keys);
+  }
+
+} // namespace sealcrypt
@@ -0,0 +1,155 @@
+#include "power_cache.hpp"
+
+#include "noise_model.hpp"
+
+#include <algorithm>
+
+namespace sealcrypt::detail {
+
+  auto powerDepth(std::uint64_t exponent) -> std::size_t {
+    std::size_t depth = 0;
+    for(std::uint64_t reach = 1; reach < exponent; reach *= 2) {
+      ++depth;
+      if(reach > exponent / 2) {
+        break; // the next doubling would pass exponent (and may overflow)
+      }
+    }
+    return depth;
+  }
+
+  auto powerFactors(std::uint64_t exponent)
+      -> std::pair< std::uint64_t, std::uint64_t > {
+    if((exponent & (exponent - 1)) == 0) {
+      return {exponent / 2, exponent / 2};
+    }
+    std::uint64_t high = 1; // largest power of two below exponent
+    while(high < exponent - high) {
+      high *= 2;
+    }
+    return {high, exponent - high};
+  }
+
+  PowerCache::PowerCache(const CryptoContext& ctx,
+                         const seal::RelinKeys& relin_keys,
+                         const seal::Ciphertext& x) :
+      ctx_(ctx), relin_keys_(relin_keys) {
+    auto& first = powers_[1];
+    if(x.size() > 2) {
+      ctx_.evaluator().relinearize(x, relin_keys_, first);
+    } else {
+      first = x;
+    }
+  }
+
+  void PowerCache::manageLevels(std::size_t max_depth,
+                                std::size_t reserve_depth) {
+    manage_levels_ = true;
+    max_depth_ = max_depth;
+    reserve_depth_ = reserve_depth;
+    for(auto& [exponent, power] : powers_) {
+      lowerLevel(power, powerDepth(exponent));
+    }
+  }
+
+  void PowerCache::lowerLevel(seal::Ciphertext& power,
+                              std::size_t depth) const {
+    if(!manage_levels_) {
+      return;
+    }
+    const auto remaining = max_depth_ - std::min(depth, max_depth_);
+    const auto target = lowestLevelFor(
+        ctx_,
+        power.parms_id(),
+        requiredBudgetBits(ctx_, remaining + reserve_depth_));
+    if(target != power.parms_id()) {
+      ctx_.evaluator().mod_switch_to_inplace(power, target);
+    }
+  }
+
+  auto PowerCache::get(std::uint64_t exponent) -> const seal::Ciphertext& {
+    auto it = powers_.find(exponent);
+    if(it != powers_.end()) {
+      return it->second;
+    }
+
+    auto& evaluator = ctx_.evaluator();
+    const auto [high_exponent, low_exponent] = powerFactors(exponent);
+    seal::Ciphertext result;
+    if(high_exponent == low_exponent) {
+      evaluator.square(get(high_exponent), result);
+    } else {
+      const auto& high = get(high_exponent);
+      const auto& low = get(low_exponent);
+
+      // Factors computed at different depths may sit at different levels,
+      // the product needs both at the lower one
+      const auto high_index = chainIndex(ctx_, high.parms_id());
+      const auto low_index = chainIndex(ctx_, low.parms_id());
+      if(high_index > low_index) {
+        evaluator.mod_switch_to(high, low.parms_id(), result);
+        evaluator.multiply_inplace(result, low);
+      } else if(low_index > high_index) {
+        evaluator.mod_switch_to(low, high.parms_id(), result);
+        evaluator.multiply_inplace(result, high);
+      } else {
+        evaluator.multiply(high, low, result);
+      }
+    }
+    evaluator.relinearize_inplace(result, relin_keys_);
+    lowerLevel(result, powerDepth(exponent));
+    return powers_.emplace(exponent, std::move(result)).first->second;
+  }
+
+  auto PowerCache::take(std::uint64_t exponent) -> seal::Ciphertext {
+    get(exponent);
+    auto node = powers_.extract(exponent);
+    return std::move(node.mapped());
+  }
+
+  auto checkPower(const KeyPair& keys, std::uint64_t exponent)
+      -> std::string {
+    if(exponent == 0) {
+      return "Exponent must be positive";
+    }
+    if(!keys.hasRelinKeys()) {
+      return "No relinearization keys available";
+    }
+    return {};
+  }
+
+  auto computePower(const CryptoContext& ctx,
+                    const seal::RelinKeys& relin_keys,
+                    const seal::Ciphertext& x,
+                    std::uint64_t exponent,
+                    const PowerOptions& options) -> seal::Ciphertext {
+    PowerCache cache(ctx, relin_keys, x);
+    if(options.mod_switch) {
+      cache.manageLevels(powerDepth(exponent), options.reserve_depth);
+    }
+    return cache.take(exponent);
+  }
+
+  auto computePowers(const CryptoContext& ctx,
+                     const seal::RelinKeys& relin_keys,
+                     const seal::Ciphertext& x,
+                     std::uint64_t count,
+                     const PowerOptions& options)
+      -> std::vector< seal::Ciphertext > {
+    PowerCache cache(ctx, relin_keys, x);
+    if(options.mod_switch) {
+      cache.manageLevels(powerDepth(count), options.reserve_depth);
+    }
+    // Compute everything before moving anything out, later powers are
+    // products of earlier ones
+    for(std::uint64_t e = 1; e <= count; ++e) {
+      cache.get(e);
+    }
+    std::vector< seal::Ciphertext > result;
+    result.reserve(count);
+    for(std::uint64_t e = 1; e <= count; ++e) {
+      result.push_back(cache.take(e));
+    }
+    return result;
+  }
+
+} // namespace sealcrypt::detail
@@ -0,0 +1,77 @@
+#pragma once
+
+// Internal cache of the powers of one ciphertext, shared by power(),
+// powers() and evaluatePolynomial(). Not part of the public API.
+
+#include "sealcrypt/context.hpp"
+#include "sealcrypt/keys.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sealcrypt::detail {
+
+  /// Multiplicative depth of x^e built by balanced products: ceil(log2(e))
+  auto powerDepth(std::uint64_t exponent) -> std::size_t;
+
+  /// The two powers x^exponent is the product of (equal for a square),
+  /// exponent >= 2
+  auto powerFactors(std::uint64_t exponent)
+      -> std::pair< std::uint64_t, std::uint64_t >;
+
+  /// Computes x^e on demand as x^(2^a) * x^(e - 2^a), 2^a < e the largest
+  /// power of two, so every power is reached at depth ceil(log2(e)) and
+  /// every intermediate power is kept for reuse. Products are relinearized.
+  class PowerCache {
+  public:
+    /// @param x Base, copied (and relinearized if it has grown)
+    PowerCache(const CryptoContext& ctx,
+               const seal::RelinKeys& relin_keys,
+               const seal::Ciphertext& x);
+
+    /// Mod switch x and every power computed from now on to the lowest
+    /// level that still leaves room for the tree up to max_depth plus
+    /// reserve_depth further multiplications
+    void manageLevels(std::size_t max_depth, std::size_t reserve_depth);
+
+    /// x^exponent (exponent >= 1), valid for the cache's lifetime
+    auto get(std::uint64_t exponent) -> const seal::Ciphertext&;
+
+    /// x^exponent moved out of the cache
+    auto take(std::uint64_t exponent) -> seal::Ciphertext;
+
+  private:
+    void lowerLevel(seal::Ciphertext& power, std::size_t depth) const;
+
+    const CryptoContext& ctx_;
+    const seal::RelinKeys& relin_keys_;
+    std::map< std::uint64_t, seal::Ciphertext > powers_; // stable references
+    bool manage_levels_ = false;
+    std::size_t max_depth_ = 0;
+    std::size_t reserve_depth_ = 0;
+  };
+
+  /// Check the arguments of power() and powers()
+  /// @return Empty, or why the call cannot proceed
+  auto checkPower(const KeyPair& keys, std::uint64_t exponent) -> std::string;
+
+  /// x^exponent, see HomomorphicInt::power()
+  auto computePower(const CryptoContext& ctx,
+                    const seal::RelinKeys& relin_keys,
+                    const seal::Ciphertext& x,
+                    std::uint64_t exponent,
+                    const PowerOptions& options) -> seal::Ciphertext;
+
+  /// x^1 .. x^count, see HomomorphicInt::powers()
+  auto computePowers(const CryptoContext& ctx,
+                     const seal::RelinKeys& relin_keys,
+                     const seal::Ciphertext& x,
+                     std::uint64_t count,
+                     const PowerOptions& options)
+      -> std::vector< seal::Ciphertext >;
+
+} // namespace sealcrypt::detail
@@ -0,0 +1,48 @@
+#pragma once
+
+// Internal helpers applying CryptoContext::relinPolicy() around ciphertext
+// multiplication. Not part of the public API.
+
+#include "sealcrypt/context.hpp"
+
+namespace sealcrypt::detail {
+
+  /// Whether ct has grown past two polynomials and the policy wants it
+  /// brought back before it is multiplied again or serialized
+  inline auto needsRelinearize(const CryptoContext& ctx,
+                               const seal::Ciphertext& ct) -> bool {
+    return ctx.relinPolicy() != RelinPolicy::Manual && ct.size() > 2;
+  }
+
+  /// Relinearize ct in place if needsRelinearize()
+  inline void relinearizeIfGrown(const CryptoContext& ctx,
+                                 seal::Ciphertext& ct) {
+    if(needsRelinearize(ctx, ct)) {
+      ctx.evaluator().relinearize_inplace(ct, ctx.relinKeys());
+    }
+  }
+
+  /// ct as it should be multiplied or written out: itself, or when
+  /// needsRelinearize() a relinearized copy in scratch. For operands that
+  /// must not be modified.
+  inline auto relinearized(const CryptoContext& ctx,
+                           const seal::Ciphertext& ct,
+                           seal::Ciphertext& scratch)
+      -> const seal::Ciphertext& {
+    if(!needsRelinearize(ctx, ct)) {
+      return ct;
+    }
+    ctx.evaluator().relinearize(ct, ctx.relinKeys(), scratch);
+    return scratch;
+  }
+
+  /// Finish a multiply or square: Eager relinearizes the product at once,
+  /// Lazy leaves it for the next multiply or save
+  inline void relinearizeProduct(const CryptoContext& ctx,
+                                 seal::Ciphertext& product) {
+    if(ctx.relinPolicy() == RelinPolicy::Eager) {
+      ctx.evaluator().relinearize_inplace(product, ctx.relinKeys());
+    }
+  }
+
+} // namespace sealcrypt::detail
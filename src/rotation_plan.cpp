@@ -0,0 +1,38 @@
+#include "sealcrypt/rotation_plan.hpp"
+
+namespace sealcrypt {
+
+  auto innerSumSteps(const CryptoContext& ctx, std::size_t count)
+      -> std::vector< int > {
+    const auto row_size = ctx.slotCount() / 2;
+    const bool both_rows = count == 0 || count > row_size;
+    const auto span = both_rows ? row_size : count;
+
+    std::vector< int > steps;
+    for(std::size_t step = 1; step < span; step *= 2) {
+      steps.push_back(static_cast< int >(step));
+    }
+    if(both_rows && row_size > 0) {
+      steps.push_back(0);
+    }
+    return steps;
+  }
+
+  auto matrixVectorSteps(std::size_t dimension) -> std::vector< int > {
+    std::size_t giant = 1;
+    while(giant * giant < dimension) {
+      ++giant;
+    }
+
+    std::vector< int > steps;
+    for(std::size_t step = 1; step < giant && step < dimension; ++step) {
+      steps.push_back(static_cast< int >(step));
+    }
+    for(std::size_t step = giant; giant > 1 && step < dimension;
+        step += giant) {
+      steps.push_back(static_cast< int >(step));
+    }
+    return steps;
+  }
+
+} // namespace sealcrypt
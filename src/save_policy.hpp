@@ -0,0 +1,35 @@
+#pragma once
+
+// Internal helper applying the context's relinearization and save policies
+// to a ciphertext about to be written out. Not part of the public API.
+
+#include "noise_model.hpp"
+#include "relin_policy.hpp"
+#include "sealcrypt/context.hpp"
+
+namespace sealcrypt::detail {
+
+  /// ct as it should be written out: relinearized if needsRelinearize(),
+  /// and under SavePolicy::Compact mod switched to compactLevel(). Returns
+  /// ct itself when neither applies, otherwise a copy in scratch.
+  inline auto preparedForSave(const CryptoContext& ctx,
+                              const seal::Ciphertext& ct,
+                              seal::Ciphertext& scratch)
+      -> const seal::Ciphertext& {
+    const auto& relinearized_ct = relinearized(ctx, ct, scratch);
+    if(ctx.savePolicy() != SavePolicy::Compact) {
+      return relinearized_ct;
+    }
+    const auto target = compactLevel(ctx, ct.parms_id(), 0);
+    if(target == ct.parms_id()) {
+      return relinearized_ct;
+    }
+    if(&relinearized_ct == &scratch) {
+      ctx.evaluator().mod_switch_to_inplace(scratch, target);
+    } else {
+      ctx.evaluator().mod_switch_to(ct, target, scratch);
+    }
+    return scratch;
+  }
+
+} // namespace sealcrypt::detail
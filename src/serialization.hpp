@@ -0,0 +1,119 @@
+#pragma once
+
+// Internal helpers for serializing SEAL objects to byte vectors. Not part of
+// the public API.
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <seal/serialization.h>
+#include <streambuf>
+#include <vector>
+
+namespace sealcrypt::detail {
+
+  /// Save a SEAL object (or Serializable) straight into a byte vector.
+  /// save_size() gives an upper bound for the compressed size, so the buffer
+  /// is allocated once and trimmed to what save() actually wrote.
+  template < typename T >
+  auto saveToBytes(const T& object, seal::compr_mode_type mode)
+      -> std::vector< std::uint8_t > {
+    std::vector< std::uint8_t > bytes(
+        static_cast< std::size_t >(object.save_size(mode)));
+    auto written =
+        object.save(reinterpret_cast< seal::seal_byte* >(bytes.data()),
+                    bytes.size(),
+                    mode);
+    bytes.resize(static_cast< std::size_t >(written));
+    return bytes;
+  }
+
+  /// Read-only, seekable streambuf over a caller-owned byte range. Lets
+  /// stream-based readers parse in-memory data without copying it first.
+  class ByteSourceBuf : public std::streambuf {
+  public:
+    ByteSourceBuf(const std::byte* data, std::size_t size) {
+      // the get area is never written through, the cast only satisfies setg
+      auto* begin = const_cast< char* >(reinterpret_cast< const char* >(data));
+      setg(begin, begin, begin + size);
+    }
+
+  protected:
+    auto seekoff(off_type offset,
+                 std::ios_base::seekdir dir,
+                 std::ios_base::openmode which) -> pos_type override {
+      if((which & std::ios_base::in) == 0) {
+        return pos_type(off_type(-1));
+      }
+      off_type base = 0;
+      if(dir == std::ios_base::cur) {
+        base = gptr() - eback();
+      } else if(dir == std::ios_base::end) {
+        base = egptr() - eback();
+      }
+      const off_type target = base + offset;
+      if(target < 0 || target > egptr() - eback()) {
+        return pos_type(off_type(-1));
+      }
+      setg(eback(), eback() + target, egptr());
+      return pos_type(target);
+    }
+
+    auto seekpos(pos_type position, std::ios_base::openmode which)
+        -> pos_type override {
+      return seekoff(off_type(position), std::ios_base::beg, which);
+    }
+  };
+
+  /// istream reading a caller-owned byte range in place
+  class ByteSource : public std::istream {
+  public:
+    ByteSource(const std::byte* data, std::size_t size) :
+        std::istream(nullptr), buf_(data, size) {
+      rdbuf(&buf_);
+    }
+
+  private:
+    ByteSourceBuf buf_;
+  };
+
+  /// Write-only streambuf appending to a byte vector
+  class ByteSinkBuf : public std::streambuf {
+  public:
+    explicit ByteSinkBuf(std::vector< std::uint8_t >& bytes) : bytes_(bytes) {
+    }
+
+  protected:
+    auto overflow(int_type ch) -> int_type override {
+      if(!traits_type::eq_int_type(ch, traits_type::eof())) {
+        bytes_.push_back(static_cast< std::uint8_t >(ch));
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    auto xsputn(const char* data, std::streamsize count)
+        -> std::streamsize override {
+      bytes_.insert(bytes_.end(),
+                    reinterpret_cast< const std::uint8_t* >(data),
+                    reinterpret_cast< const std::uint8_t* >(data) + count);
+      return count;
+    }
+
+  private:
+    std::vector< std::uint8_t >& bytes_;
+  };
+
+  /// ostream appending everything written to a byte vector
+  class ByteSink : public std::ostream {
+  public:
+    explicit ByteSink(std::vector< std::uint8_t >& bytes) :
+        std::ostream(nullptr), buf_(bytes) {
+      rdbuf(&buf_);
+    }
+
+  private:
+    ByteSinkBuf buf_;
+  };
+
+} // namespace sealcrypt::detail
@@ -0,0 +1,113 @@
+#include "sealcrypt/session.hpp"
+
+#include <exception>
+#include <seal/decryptor.h>
+#include <seal/encryptor.h>
+#include <stdexcept>
+
+namespace sealcrypt {
+
+  struct CryptoSession::Impl {
+    const CryptoContext& ctx;
+    const KeyPair& keys;
+    std::unique_ptr< seal::Encryptor > encryptor;
+    std::unique_ptr< seal::Decryptor > decryptor;
+    bool public_encryption = false;
+    bool symmetric_encryption = false;
+    std::string last_error;
+
+    Impl(const CryptoContext& context, const KeyPair& key_pair) :
+        ctx(context),
+        keys(key_pair) {
+    }
+  };
+
+  CryptoSession::CryptoSession(const CryptoContext& ctx, const KeyPair& keys) :
+      impl_(std::make_unique< Impl >(ctx, keys)) {
+    if(!ctx.isValid()) {
+      impl_->last_error = "Invalid crypto context";
+      return;
+    }
+    try {
+      // One encryptor serves both modes, it holds whichever keys exist
+      if(keys.hasPublicKey()) {
+        impl_->encryptor = std::make_unique< seal::Encryptor >(
+            ctx.sealContext(), keys.publicKey());
+        impl_->public_encryption = true;
+      }
+      if(keys.hasSecretKey()) {
+        if(impl_->encryptor) {
+          impl_->encryptor->set_secret_key(keys.secretKey());
+        } else {
+          impl_->encryptor = std::make_unique< seal::Encryptor >(
+              ctx.sealContext(), keys.secretKey());
+        }
+        impl_->symmetric_encryption = true;
+        impl_->decryptor = std::make_unique< seal::Decryptor >(
+            ctx.sealContext(), keys.secretKey());
+      }
+      if(!impl_->encryptor && !impl_->decryptor) {
+        impl_->last_error = "No public or secret key available";
+      }
+    } catch(const std::exception& e) {
+      impl_->encryptor.reset();
+      impl_->decryptor.reset();
+      impl_->public_encryption = false;
+      impl_->symmetric_encryption = false;
+      impl_->last_error = "Session setup failed: " + std::string(e.what());
+    }
+  }
+
+  CryptoSession::~CryptoSession() = default;
+
+  CryptoSession::CryptoSession(CryptoSession&&) noexcept = default;
+  auto CryptoSession::operator=(CryptoSession&&) noexcept
+      -> CryptoSession& = default;
+
+  auto CryptoSession::isValid() const -> bool {
+    return impl_ && (impl_->encryptor || impl_->decryptor);
+  }
+
+  auto CryptoSession::getLastError() const -> std::string {
+    return impl_ ? impl_->last_error : "Session not initialized";
+  }
+
+  auto CryptoSession::hasEncryptor() const -> bool {
+    return impl_ && impl_->public_encryption;
+  }
+
+  auto CryptoSession::hasSymmetricEncryptor() const -> bool {
+    return impl_ && impl_->symmetric_encryption;
+  }
+
+  auto CryptoSession::hasDecryptor() const -> bool {
+    return impl_ && impl_->decryptor != nullptr;
+  }
+
+  auto CryptoSession::encryptor() const -> const seal::Encryptor& {
+    if(!impl_ || !impl_->encryptor) {
+      throw std::runtime_error("Encryptor not available");
+    }
+    return *impl_->encryptor;
+  }
+
+  auto CryptoSession::decryptor() const -> seal::Decryptor& {
+    if(!hasDecryptor()) {
+      throw std::runtime_error("Decryptor not available");
+    }
+    return *impl_->decryptor;
+  }
+
+  auto CryptoSession::batchEncoder() const -> const seal::BatchEncoder& {
+    return impl_->ctx.batchEncoder();
+  }
+
+  auto CryptoSession::context() const -> const CryptoContext& {
+    return impl_->ctx;
+  }
+
+  auto CryptoSession::keys() const -> const KeyPair& {
+    return impl_->keys;
+  }
+
+} // namespace sealcrypt
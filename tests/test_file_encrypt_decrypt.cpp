@@ -0,0 +1,147 @@
+// Test: Encryptor::encryptFile() / Decryptor::decryptFile() round trip
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, FileRoundTripSpansChunks) {
+  // not a multiple of the chunk size, and starts with a zero byte
+  std::vector< std::uint8_t > data(5000);
+  for(auto& byte : data) {
+    byte = static_cast< std::uint8_t >(randomInt(1, 255));
+  }
+  data[0] = 0;
+
+  const std::string plain_path = "test_file_plain.bin";
+  const std::string enc_path = "test_file_plain.enc";
+  const std::string dec_path = "test_file_plain.dec";
+  writeBytes(plain_path, data);
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  ASSERT_TRUE(encryptor.encryptFile(plain_path, enc_path, *keys))
+      << encryptor.getLastError();
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  ASSERT_TRUE(decryptor.decryptFile(enc_path, dec_path, *keys))
+      << decryptor.getLastError();
+  EXPECT_EQ(readBytes(dec_path), data);
+
+  // the file and in-memory paths produce the same layout
+  auto from_bytes = decryptor.decryptBytes(readBytes(enc_path), *keys);
+  EXPECT_EQ(from_bytes, data);
+
+  remove(plain_path.c_str());
+  remove(enc_path.c_str());
+  remove(dec_path.c_str());
+}
+
+TEST_F(CryptoTestFixture, FileRoundTripTrailingZeros) {
+  // SEAL drops trailing zero coefficients on decryption, chunks ending in
+  // zero bytes (and an all-zero chunk) must still come back intact
+  std::vector< std::uint8_t > data(3000, 0);
+  for(std::size_t i = 0; i < 900; ++i) {
+    data[i] = static_cast< std::uint8_t >(randomInt(1, 255));
+  }
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  auto encrypted = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(encrypted.empty()) << encryptor.getLastError();
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_EQ(decryptor.decryptBytes(encrypted, *keys), data);
+}
+
+TEST_F(CryptoTestFixture, FileDecryptBytesView) {
+  std::vector< std::uint8_t > data(20000);
+  for(auto& byte : data) {
+    byte = static_cast< std::uint8_t >(randomInt(0, 255));
+  }
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  auto encrypted = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(encrypted.empty()) << encryptor.getLastError();
+
+  // The encrypted bytes sit in the middle of a larger caller buffer
+  std::vector< std::byte > arena(encrypted.size() + 100);
+  std::memcpy(arena.data() + 50, encrypted.data(), encrypted.size());
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  for(std::size_t threads : {1u, 3u}) {
+    decryptor.setThreadCount(threads);
+    EXPECT_EQ(decryptor.decryptBytes(
+                  arena.data() + 50, encrypted.size(), *keys),
+              data)
+        << threads;
+  }
+}
+
+TEST_F(CryptoTestFixture, FileDecryptTruncated) {
+  std::vector< std::uint8_t > data(2048, 7);
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  auto encrypted = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(encrypted.empty());
+  encrypted.resize(encrypted.size() / 2);
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_TRUE(decryptor.decryptBytes(encrypted, *keys).empty());
+  EXPECT_FALSE(decryptor.getLastError().empty());
+}
+
+TEST_F(CryptoTestFixture, FileRoundTripEmpty) {
+  const std::string plain_path = "test_file_empty.bin";
+  const std::string enc_path = "test_file_empty.enc";
+  const std::string dec_path = "test_file_empty.dec";
+  writeBytes(plain_path, {});
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  ASSERT_TRUE(encryptor.encryptFile(plain_path, enc_path, *keys))
+      << encryptor.getLastError();
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  ASSERT_TRUE(decryptor.decryptFile(enc_path, dec_path, *keys))
+      << decryptor.getLastError();
+  EXPECT_TRUE(readBytes(dec_path).empty());
+
+  remove(plain_path.c_str());
+  remove(enc_path.c_str());
+  remove(dec_path.c_str());
+}
+
+TEST_F(CryptoTestFixture, FileEncryptMissingInput) {
+  sealcrypt::Encryptor encryptor(*ctx);
+  EXPECT_FALSE(encryptor.encryptFile(
+      "does_not_exist.bin", "does_not_exist.enc", *keys));
+  EXPECT_FALSE(encryptor.getLastError().empty());
+}
+
+#ifndef _WIN32
+TEST_F(CryptoTestFixture, FileEncryptPipeInput) {
+  const std::string fifo_path = "test_encrypt_input.fifo";
+  remove(fifo_path.c_str());
+  ASSERT_EQ(mkfifo(fifo_path.c_str(), 0600), 0);
+
+  // Opening a FIFO blocks until the other end is opened too
+  std::thread writer([&] { std::ofstream(fifo_path, std::ios::binary); });
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  EXPECT_FALSE(
+      encryptor.encryptFile(fifo_path, "test_encrypt_pipe.enc", *keys));
+  EXPECT_NE(encryptor.getLastError().find("not seekable"), std::string::npos)
+      << encryptor.getLastError();
+
+  writer.join();
+  remove(fifo_path.c_str());
+  remove("test_encrypt_pipe.enc");
+}
+#endif
@@ -0,0 +1,105 @@
+// Test: Encryptor::setPackingMode() and the encrypted file header
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, DensePackingIsDefaultAndSmaller) {
+  auto data = randomBytes(20000);
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  EXPECT_EQ(encryptor.packingMode(), sealcrypt::PackingMode::Dense);
+  auto dense = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(dense.empty()) << encryptor.getLastError();
+
+  encryptor.setPackingMode(sealcrypt::PackingMode::Sparse);
+  auto sparse = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(sparse.empty()) << encryptor.getLastError();
+
+  // 4096 coefficients x 16 bits against 1024 x 8 bits per ciphertext
+  EXPECT_LT(dense.size() * 4, sparse.size());
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_EQ(decryptor.decryptBytes(dense, *keys), data);
+  EXPECT_EQ(decryptor.decryptBytes(sparse, *keys), data);
+}
+
+TEST_F(CryptoTestFixture, DensePackingOddBitWidth) {
+  // t = 40961 leaves 15 bits per coefficient, fields straddle bytes
+  ctx = std::make_unique< sealcrypt::CryptoContext >(4096, 40961);
+  ASSERT_TRUE(ctx->isValid()) << ctx->getLastError();
+  keys = std::make_unique< sealcrypt::KeyPair >(*ctx);
+  ASSERT_TRUE(keys->generate());
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  sealcrypt::Decryptor decryptor(*ctx);
+  for(std::size_t size : {1u, 7680u, 7681u, 20000u}) {
+    auto data = randomBytes(size);
+    auto encrypted = encryptor.encryptBytes(data, *keys);
+    ASSERT_FALSE(encrypted.empty()) << encryptor.getLastError();
+    EXPECT_EQ(decryptor.decryptBytes(encrypted, *keys), data) << size;
+  }
+
+  // t = 17 leaves 4 bits, every byte spans two coefficients
+  ctx = std::make_unique< sealcrypt::CryptoContext >(4096, 17);
+  ASSERT_TRUE(ctx->isValid()) << ctx->getLastError();
+  keys = std::make_unique< sealcrypt::KeyPair >(*ctx);
+  ASSERT_TRUE(keys->generate());
+
+  sealcrypt::Encryptor narrow_encryptor(*ctx);
+  sealcrypt::Decryptor narrow_decryptor(*ctx);
+  for(std::size_t size : {1u, 2048u, 2049u, 5000u}) {
+    auto data = randomBytes(size);
+    auto encrypted = narrow_encryptor.encryptBytes(data, *keys);
+    ASSERT_FALSE(encrypted.empty()) << narrow_encryptor.getLastError();
+    EXPECT_EQ(narrow_decryptor.decryptBytes(encrypted, *keys), data) << size;
+  }
+}
+
+TEST_F(CryptoTestFixture, LegacyLayoutStillDecrypts) {
+  // original size, ciphertext count, then one byte per coefficient
+  auto data = randomBytes(1500);
+  std::ostringstream oss(std::ios::binary);
+  std::size_t original_size = data.size();
+  std::size_t count = 2;
+  oss.write(reinterpret_cast< const char* >(&original_size),
+            sizeof(original_size));
+  oss.write(reinterpret_cast< const char* >(&count), sizeof(count));
+
+  sealcrypt::CryptoSession session(*ctx, *keys);
+  for(std::size_t i = 0; i < data.size(); i += 1024) {
+    std::size_t length = std::min< std::size_t >(1024, data.size() - i);
+    seal::Plaintext plaintext(length);
+    for(std::size_t j = 0; j < length; ++j) {
+      plaintext[j] = data[i + j];
+    }
+    seal::Ciphertext ciphertext;
+    session.encryptor().encrypt(plaintext, ciphertext);
+    ciphertext.save(oss);
+  }
+
+  std::string str = oss.str();
+  std::vector< std::uint8_t > legacy(str.begin(), str.end());
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_EQ(decryptor.decryptBytes(legacy, *keys), data)
+      << decryptor.getLastError();
+}
+
+TEST_F(CryptoTestFixture, PackedForLargerDegreeIsRejected) {
+  sealcrypt::CryptoContext medium(sealcrypt::SecurityLevel::Medium);
+  sealcrypt::KeyPair medium_keys(medium);
+  ASSERT_TRUE(medium_keys.generate());
+
+  sealcrypt::Encryptor encryptor(medium);
+  auto encrypted = encryptor.encryptBytes(randomBytes(100), medium_keys);
+  ASSERT_FALSE(encrypted.empty());
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_TRUE(decryptor.decryptBytes(encrypted, *keys).empty());
+  EXPECT_FALSE(decryptor.getLastError().empty());
+}
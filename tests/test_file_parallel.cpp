@@ -0,0 +1,88 @@
+// Test: Encryptor / Decryptor setThreadCount() parallel pipeline
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, ThreadCountDefaultsToHardware) {
+  sealcrypt::Encryptor encryptor(*ctx);
+  EXPECT_GE(encryptor.threadCount(), 1u);
+
+  encryptor.setThreadCount(3);
+  EXPECT_EQ(encryptor.threadCount(), 3u);
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  decryptor.setThreadCount(0);
+  EXPECT_GE(decryptor.threadCount(), 1u);
+}
+
+TEST_F(CryptoTestFixture, ParallelMatchesSequential) {
+  // many more chunks than threads, the last one partial
+  auto data = randomBytes(8192 * 37 + 11);
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  sealcrypt::Decryptor decryptor(*ctx);
+
+  encryptor.setThreadCount(4);
+  auto parallel = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(parallel.empty()) << encryptor.getLastError();
+
+  encryptor.setThreadCount(1);
+  auto sequential = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(sequential.empty()) << encryptor.getLastError();
+
+  // ciphertexts are randomized, but the layout must match exactly
+  EXPECT_EQ(parallel.size(), sequential.size());
+
+  for(std::size_t threads : {1u, 4u}) {
+    decryptor.setThreadCount(threads);
+    EXPECT_EQ(decryptor.decryptBytes(parallel, *keys), data) << threads;
+    EXPECT_EQ(decryptor.decryptBytes(sequential, *keys), data) << threads;
+  }
+}
+
+TEST_F(CryptoTestFixture, ParallelFileWithSession) {
+  auto data = randomBytes(100000);
+  sealcrypt::CryptoSession session(*ctx, *keys);
+
+  const std::string plain_path = "test_parallel_plain.bin";
+  const std::string enc_path = "test_parallel_plain.enc";
+  const std::string dec_path = "test_parallel_plain.dec";
+  writeBytes(plain_path, data);
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  encryptor.setThreadCount(3);
+  ASSERT_TRUE(encryptor.encryptFile(plain_path, enc_path, session))
+      << encryptor.getLastError();
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  decryptor.setThreadCount(3);
+  ASSERT_TRUE(decryptor.decryptFile(enc_path, dec_path, session))
+      << decryptor.getLastError();
+
+  std::vector< std::uint8_t > decrypted;
+  std::string error;
+  ASSERT_TRUE(sealcrypt::FileHandler::readFile(dec_path, decrypted, error));
+  EXPECT_EQ(decrypted, data);
+
+  remove(plain_path.c_str());
+  remove(enc_path.c_str());
+  remove(dec_path.c_str());
+}
+
+TEST_F(CryptoTestFixture, ParallelDecryptTruncated) {
+  auto data = randomBytes(8192 * 8);
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  auto encrypted = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(encrypted.empty());
+  encrypted.resize(encrypted.size() - 100);
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  decryptor.setThreadCount(4);
+  EXPECT_TRUE(decryptor.decryptBytes(encrypted, *keys).empty());
+  EXPECT_FALSE(decryptor.getLastError().empty());
+}
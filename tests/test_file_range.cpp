@@ -0,0 +1,132 @@
+// Test: Decryptor::decryptRange() and the chunk offset table
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace sealcrypt::test;
+
+namespace {
+
+  auto slice(const std::vector< std::uint8_t >& data,
+             std::size_t offset,
+             std::size_t length) -> std::vector< std::uint8_t > {
+    auto begin = data.begin() + static_cast< std::ptrdiff_t >(offset);
+    return {begin, begin + static_cast< std::ptrdiff_t >(length)};
+  }
+
+} // namespace
+
+TEST_F(CryptoTestFixture, RangeMatchesSlice) {
+  // Low preset: 8192 plaintext bytes per chunk
+  auto data = randomBytes(8192 * 6 + 500);
+  const std::string plain_path = "test_range_plain.bin";
+  const std::string enc_path = "test_range_plain.enc";
+  writeBytes(plain_path, data);
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  ASSERT_TRUE(encryptor.encryptFile(plain_path, enc_path, *keys))
+      << encryptor.getLastError();
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  const std::vector< std::pair< std::size_t, std::size_t > > ranges {
+      {0, 1},           // first byte
+      {8191, 2},        // straddles a chunk boundary
+      {10000, 20000},   // spans several chunks
+      {8192 * 6, 500},  // exactly the partial last chunk
+      {data.size() - 1, 1}};
+  for(const auto& [offset, length] : ranges) {
+    EXPECT_EQ(decryptor.decryptRange(enc_path, offset, length, *keys),
+              slice(data, offset, length))
+        << offset << "+" << length << ": " << decryptor.getLastError();
+  }
+
+  // clipped at the end, empty at the end, error past the end
+  EXPECT_EQ(decryptor.decryptRange(enc_path, data.size() - 10, 100, *keys),
+            slice(data, data.size() - 10, 10));
+  EXPECT_TRUE(decryptor.decryptRange(enc_path, data.size(), 10, *keys)
+                  .empty());
+  EXPECT_TRUE(decryptor.decryptRange(enc_path, data.size() + 1, 1, *keys)
+                  .empty());
+  EXPECT_FALSE(decryptor.getLastError().empty());
+
+  remove(plain_path.c_str());
+  remove(enc_path.c_str());
+}
+
+TEST_F(CryptoTestFixture, RangeSeeksPastUnreadChunks) {
+  auto data = randomBytes(8192 * 4);
+  sealcrypt::Encryptor encryptor(*ctx);
+  auto encrypted = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(encrypted.empty());
+
+  // Corrupt the SEAL header of the first ciphertext (after the 88 byte
+  // file header and 5 offsets): a range in a later chunk must not touch
+  // it, a full decryption must fail
+  const std::size_t header_size = 88 + 8 * 5;
+  encrypted[header_size + 1] ^= 0xFF;
+
+  const std::string enc_path = "test_range_seek.enc";
+  writeBytes(enc_path, encrypted);
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_EQ(decryptor.decryptRange(enc_path, 8192 * 3 + 5, 64, *keys),
+            slice(data, 8192 * 3 + 5, 64))
+      << decryptor.getLastError();
+  EXPECT_TRUE(decryptor.decryptBytes(encrypted, *keys).empty());
+
+  remove(enc_path.c_str());
+}
+
+TEST_F(CryptoTestFixture, RangeOnLegacyLayout) {
+  // headerless layout without an offset table
+  auto data = randomBytes(3000);
+  std::ostringstream oss(std::ios::binary);
+  std::size_t original_size = data.size();
+  std::size_t count = 3;
+  oss.write(reinterpret_cast< const char* >(&original_size),
+            sizeof(original_size));
+  oss.write(reinterpret_cast< const char* >(&count), sizeof(count));
+
+  sealcrypt::CryptoSession session(*ctx, *keys);
+  for(std::size_t i = 0; i < data.size(); i += 1024) {
+    std::size_t length = std::min< std::size_t >(1024, data.size() - i);
+    seal::Plaintext plaintext(length);
+    for(std::size_t j = 0; j < length; ++j) {
+      plaintext[j] = data[i + j];
+    }
+    seal::Ciphertext ciphertext;
+    session.encryptor().encrypt(plaintext, ciphertext);
+    ciphertext.save(oss);
+  }
+
+  const std::string enc_path = "test_range_legacy.enc";
+  std::string str = oss.str();
+  writeBytes(enc_path, {str.begin(), str.end()});
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_EQ(decryptor.decryptRange(enc_path, 2000, 900, session),
+            slice(data, 2000, 900))
+      << decryptor.getLastError();
+
+  remove(enc_path.c_str());
+}
+
+TEST_F(CryptoTestFixture, HeaderRejectsOtherParameters) {
+  // same degree and packing width, different plain modulus
+  sealcrypt::CryptoContext other(4096, 40961);
+  ASSERT_TRUE(other.isValid());
+  sealcrypt::KeyPair other_keys(other);
+  ASSERT_TRUE(other_keys.generate());
+
+  sealcrypt::Encryptor encryptor(other);
+  auto encrypted = encryptor.encryptBytes(randomBytes(100), other_keys);
+  ASSERT_FALSE(encrypted.empty());
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_TRUE(decryptor.decryptBytes(encrypted, *keys).empty());
+  EXPECT_NE(decryptor.getLastError().find("parameters"), std::string::npos)
+      << decryptor.getLastError();
+}
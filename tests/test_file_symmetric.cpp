@@ -0,0 +1,57 @@
+// Test: Encryptor EncryptionMode::Symmetric seeded file encryption
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, SymmetricFileIsSmaller) {
+  std::vector< std::uint8_t > data(20000);
+  for(auto& byte : data) {
+    byte = static_cast< std::uint8_t >(randomInt(0, 255));
+  }
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  EXPECT_EQ(encryptor.encryptionMode(), sealcrypt::EncryptionMode::PublicKey);
+  auto public_bytes = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(public_bytes.empty()) << encryptor.getLastError();
+
+  encryptor.setEncryptionMode(sealcrypt::EncryptionMode::Symmetric);
+  auto seeded = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(seeded.empty()) << encryptor.getLastError();
+  EXPECT_LT(seeded.size(), public_bytes.size() * 3 / 4);
+
+  // Decryption does not care which key encrypted the data
+  sealcrypt::Decryptor decryptor(*ctx);
+  for(std::size_t threads : {1u, 3u}) {
+    decryptor.setThreadCount(threads);
+    EXPECT_EQ(decryptor.decryptBytes(seeded, *keys), data) << threads;
+  }
+
+  // The parallel path writes the same seeded layout
+  encryptor.setThreadCount(3);
+  auto parallel = encryptor.encryptBytes(data, *keys);
+  EXPECT_EQ(parallel.size(), seeded.size());
+  EXPECT_EQ(decryptor.decryptBytes(parallel, *keys), data);
+}
+
+TEST_F(CryptoTestFixture, SymmetricNeedsSecretKey) {
+  auto path = ::testing::TempDir() + "sealcrypt_symmetric_pub.key";
+  auto secret_path = ::testing::TempDir() + "sealcrypt_symmetric_priv.key";
+  ASSERT_TRUE(keys->save(path, secret_path));
+
+  sealcrypt::KeyPair public_only(*ctx);
+  ASSERT_TRUE(public_only.loadPublicKey(path));
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  encryptor.setEncryptionMode(sealcrypt::EncryptionMode::Symmetric);
+  EXPECT_TRUE(encryptor.encryptBytes({1, 2, 3}, public_only).empty());
+  EXPECT_EQ(encryptor.getLastError(), "No secret key available");
+
+  sealcrypt::CryptoSession session(*ctx, public_only);
+  EXPECT_TRUE(session.hasEncryptor());
+  EXPECT_FALSE(session.hasSymmetricEncryptor());
+  EXPECT_TRUE(encryptor.encryptBytes({1, 2, 3}, session).empty());
+}
@@ -2,17 +2,21 @@
 
 #include "sealcrypt/sealcrypt.hpp"
 
+#include <fstream>
 #include <gtest/gtest.h>
+#include <iterator>
 #include <random>
+#include <string>
+#include <vector>
 
 namespace sealcrypt::test {
 
-  /// Test fixture for common setup (context and keys)
-  class CryptoTestFixture : public ::testing::Test {
+  /// Test fixture for common setup (context and keys) at one security level
+  template < sealcrypt::SecurityLevel Level >
+  class LevelCryptoTestFixture : public ::testing::Test {
   protected:
     auto SetUp() -> void override {
-      ctx = std::make_unique< sealcrypt::CryptoContext >(
-          sealcrypt::SecurityLevel::Low);
+      ctx = std::make_unique< sealcrypt::CryptoContext >(Level);
       ASSERT_TRUE(ctx->isValid()) << "Failed to create crypto context";
 
       keys = std::make_unique< sealcrypt::KeyPair >(*ctx);
@@ -34,6 +38,40 @@ namespace sealcrypt::test {
       std::uniform_int_distribution< std::int64_t > dist(min, max);
       return dist(gen);
     }
+
+    // Helper for random file contents
+    static auto randomBytes(std::size_t size) -> std::vector< std::uint8_t > {
+      static std::mt19937 gen(std::random_device {}());
+      std::uniform_int_distribution< int > dist(0, 255);
+      std::vector< std::uint8_t > data(size);
+      for(auto& byte : data) {
+        byte = static_cast< std::uint8_t >(dist(gen));
+      }
+      return data;
+    }
   };
 
+  /// Fast parameters, for most tests
+  using CryptoTestFixture
+      = LevelCryptoTestFixture< sealcrypt::SecurityLevel::Low >;
+
+  /// A longer modulus chain, for tests that mod switch or need noise budget
+  /// for several products
+  using MediumCryptoTestFixture
+      = LevelCryptoTestFixture< sealcrypt::SecurityLevel::Medium >;
+
+  inline auto writeBytes(const std::string& path,
+                         const std::vector< std::uint8_t >& data) -> void {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast< const char* >(data.data()),
+              static_cast< std::streamsize >(data.size()));
+  }
+
+  inline auto readBytes(const std::string& path)
+      -> std::vector< std::uint8_t > {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator< char >(in),
+            std::istreambuf_iterator< char >()};
+  }
+
 } // namespace sealcrypt::test
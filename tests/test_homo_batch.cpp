@@ -0,0 +1,68 @@
+// Test: HomomorphicInt::encryptMany() / decryptMany() thread pool batches
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, BatchRoundTrip) {
+  std::vector< std::int64_t > values(101);
+  for(auto& value : values) {
+    value = randomInt(0, 30000); // sums stay below t = 65537
+  }
+
+  for(std::size_t threads : {1u, 4u}) {
+    auto encrypted =
+        sealcrypt::HomomorphicInt::encryptMany(values, *ctx, *keys, threads);
+    ASSERT_EQ(encrypted.size(), values.size());
+    for(const auto& value : encrypted) {
+      ASSERT_TRUE(value.isValid()) << value.getLastError();
+    }
+
+    EXPECT_EQ(
+        sealcrypt::HomomorphicInt::decryptMany(encrypted, *ctx, *keys, threads),
+        values)
+        << threads;
+
+    // results are ordinary ciphertexts
+    auto sum = encrypted[0] + encrypted[1];
+    EXPECT_EQ(sum.decrypt(*ctx, *keys), values[0] + values[1]);
+  }
+}
+
+TEST_F(CryptoTestFixture, BatchIntoPreallocatedArrays) {
+  const std::int64_t values[] = {5, -3, 0, 42, 65536};
+  const std::size_t count = std::size(values);
+
+  // Reused output arrays, as a caller processing batch after batch would
+  std::vector< sealcrypt::HomomorphicInt > encrypted(count);
+  std::vector< std::int64_t > decrypted(count, -1);
+  for(int round = 0; round < 2; ++round) {
+    ASSERT_TRUE(sealcrypt::HomomorphicInt::encryptMany(
+        values, count, encrypted.data(), *ctx, *keys, 3));
+    sealcrypt::HomomorphicInt::decryptMany(
+        encrypted.data(), count, decrypted.data(), *ctx, *keys, 3);
+
+    for(std::size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(decrypted[i], encrypted[i].decrypt(*ctx, *keys));
+    }
+    EXPECT_EQ(decrypted[0], 5);
+    EXPECT_EQ(decrypted[3], 42);
+  }
+}
+
+TEST_F(CryptoTestFixture, BatchNeedsKeys) {
+  sealcrypt::KeyPair empty(*ctx);
+  const std::int64_t values[] = {1, 2};
+  sealcrypt::HomomorphicInt out[2];
+  EXPECT_FALSE(sealcrypt::HomomorphicInt::encryptMany(
+      values, 2, out, *ctx, empty));
+  EXPECT_FALSE(out[0].isValid());
+
+  std::int64_t decrypted[2] = {7, 7};
+  sealcrypt::HomomorphicInt::decryptMany(out, 2, decrypted, *ctx, empty);
+  EXPECT_EQ(decrypted[0], 0);
+  EXPECT_EQ(decrypted[1], 0);
+}
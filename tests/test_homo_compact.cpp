@@ -0,0 +1,94 @@
+// Test: HomomorphicInt::compact() and SavePolicy::Compact
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+namespace {
+
+  // Tests run on Medium, which has enough levels to drop some; Low's chain
+  // is too short
+  auto level(const sealcrypt::CryptoContext& ctx, const seal::Ciphertext& ct)
+      -> std::size_t {
+    return ctx.sealContext().get_context_data(ct.parms_id())->chain_index();
+  }
+
+} // namespace
+
+TEST_F(MediumCryptoTestFixture, CompactShrinksAndDecrypts) {
+  auto enc = sealcrypt::HomomorphicInt::encrypt(1234, *ctx, *keys);
+  auto compacted = enc.compact(*ctx);
+  ASSERT_TRUE(compacted.isValid());
+
+  EXPECT_LT(level(*ctx, compacted.ciphertext()), level(*ctx, enc.ciphertext()));
+  EXPECT_LT(compacted.serialize(*ctx).size(), enc.serialize(*ctx).size());
+  EXPECT_EQ(compacted.decrypt(*ctx, *keys), 1234);
+
+  // Keeping room for a product stops at a higher level
+  auto reserved = enc.compact(*ctx, 1);
+  EXPECT_GE(level(*ctx, reserved.ciphertext()),
+            level(*ctx, compacted.ciphertext()));
+  EXPECT_EQ((reserved * reserved).decrypt(*ctx, *keys), 1234 * 1234 % 65537);
+
+  auto moved = std::move(enc).compact(*ctx);
+  EXPECT_EQ(level(*ctx, moved.ciphertext()),
+            level(*ctx, compacted.ciphertext()));
+  EXPECT_EQ(moved.decrypt(*ctx, *keys), 1234);
+}
+
+TEST_F(MediumCryptoTestFixture, SavePolicyCompact) {
+  auto enc = sealcrypt::HomomorphicInt::encrypt(77, *ctx, *keys);
+  EXPECT_EQ(ctx->savePolicy(), sealcrypt::SavePolicy::Full);
+  auto full = enc.serialize(*ctx);
+
+  ctx->setSavePolicy(sealcrypt::SavePolicy::Compact);
+  auto compact = enc.serialize(*ctx);
+  EXPECT_LT(compact.size(), full.size());
+
+  // The value itself is untouched, only what is written
+  EXPECT_EQ(level(*ctx, enc.ciphertext()),
+            ctx->sealContext().first_context_data()->chain_index());
+
+  sealcrypt::HomomorphicInt loaded;
+  ASSERT_TRUE(loaded.deserialize(compact, *ctx));
+  EXPECT_EQ(loaded.decrypt(*ctx, *keys), 77);
+
+  std::vector< std::byte > buffer(enc.saveSize(*ctx));
+  auto written = enc.serializeTo(buffer.data(), buffer.size(), *ctx);
+  EXPECT_EQ(written, compact.size());
+}
+
+TEST_F(MediumCryptoTestFixture, VectorCompact) {
+  std::vector< std::int64_t > values {1, -2, 3};
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+  auto compacted = enc.compact(*ctx);
+  ASSERT_TRUE(compacted.isValid());
+  EXPECT_LT(level(*ctx, compacted.ciphertext()), level(*ctx, enc.ciphertext()));
+
+  auto result = compacted.decrypt(*ctx, *keys);
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(result[i], values[i]) << "slot " << i;
+  }
+}
+
+TEST_F(MediumCryptoTestFixture, FileSavePolicyCompact) {
+  std::vector< std::uint8_t > data(5000);
+  for(std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast< std::uint8_t >(i * 31);
+  }
+
+  sealcrypt::Encryptor encryptor(*ctx);
+  auto full = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(full.empty()) << encryptor.getLastError();
+
+  ctx->setSavePolicy(sealcrypt::SavePolicy::Compact);
+  auto compact = encryptor.encryptBytes(data, *keys);
+  ASSERT_FALSE(compact.empty()) << encryptor.getLastError();
+  EXPECT_LT(compact.size(), full.size() * 3 / 4);
+
+  sealcrypt::Decryptor decryptor(*ctx);
+  EXPECT_EQ(decryptor.decryptBytes(compact, *keys), data);
+}
@@ -0,0 +1,55 @@
+// Test: CryptoContext::setCompression() applied by the save paths
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, CompressionDefaultsToSeal) {
+  EXPECT_EQ(ctx->sealComprMode(), seal::Serialization::compr_mode_default);
+  EXPECT_TRUE(
+      sealcrypt::CryptoContext::isCompressionSupported(ctx->compression()));
+  EXPECT_TRUE(ctx->setCompression(sealcrypt::Compression::None));
+  EXPECT_EQ(ctx->compression(), sealcrypt::Compression::None);
+}
+
+TEST_F(CryptoTestFixture, CompressionAppliesToSerialize) {
+  std::int64_t value = randomInt(0, 10000);
+  auto enc = sealcrypt::HomomorphicInt::encrypt(value, *ctx, *keys);
+
+  ASSERT_TRUE(ctx->setCompression(sealcrypt::Compression::None));
+  auto plain_bytes = enc.serialize(*ctx);
+  ASSERT_FALSE(plain_bytes.empty());
+
+  for(auto mode :
+      {sealcrypt::Compression::Zlib, sealcrypt::Compression::Zstd}) {
+    if(!sealcrypt::CryptoContext::isCompressionSupported(mode)) {
+      EXPECT_FALSE(ctx->setCompression(mode));
+      continue;
+    }
+    ASSERT_TRUE(ctx->setCompression(mode));
+    auto bytes = enc.serialize(*ctx);
+    EXPECT_LT(bytes.size(), plain_bytes.size());
+
+    // the reader needs no matching setting
+    ASSERT_TRUE(ctx->setCompression(sealcrypt::Compression::None));
+    sealcrypt::HomomorphicInt loaded;
+    ASSERT_TRUE(loaded.deserialize(bytes, *ctx));
+    EXPECT_EQ(loaded.decrypt(*ctx, *keys), value);
+  }
+}
+
+TEST_F(CryptoTestFixture, CompressionAppliesToKeys) {
+  const std::string pub = ::testing::TempDir() + "sealcrypt_compr_pub.key";
+  const std::string priv = ::testing::TempDir() + "sealcrypt_compr_priv.key";
+
+  ASSERT_TRUE(ctx->setCompression(sealcrypt::Compression::None));
+  ASSERT_TRUE(keys->save(pub, priv)) << keys->getLastError();
+
+  sealcrypt::KeyPair loaded(*ctx);
+  ASSERT_TRUE(loaded.load(pub, priv)) << loaded.getLastError();
+  auto enc = sealcrypt::HomomorphicInt::encrypt(77, *ctx, loaded);
+  EXPECT_EQ(enc.decrypt(*ctx, *keys), 77);
+}
@@ -0,0 +1,134 @@
+// Test: lazy Expression DAG evaluation
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+#include <utility>
+
+using namespace sealcrypt::test;
+using sealcrypt::HomomorphicInt;
+using sealcrypt::lazy;
+
+TEST_F(CryptoTestFixture, ExpressionEvaluates) {
+  auto a = HomomorphicInt::encrypt(2, *ctx, *keys);
+  auto b = HomomorphicInt::encrypt(3, *ctx, *keys);
+  auto c = HomomorphicInt::encrypt(4, *ctx, *keys);
+  auto d = HomomorphicInt::encrypt(5, *ctx, *keys);
+  auto e = HomomorphicInt::encrypt(7, *ctx, *keys);
+
+  auto expr = lazy(a) * lazy(b) + lazy(c) * lazy(d) - lazy(e);
+  EXPECT_EQ(expr.operationCount(), 4u);
+  EXPECT_EQ(expr.decrypt(*ctx, *keys), 19);
+
+  // Leaves are untouched, the expression can be evaluated again
+  EXPECT_EQ(a.decrypt(*ctx, *keys), 2);
+  EXPECT_EQ(expr.evaluate(*ctx).decrypt(*ctx, *keys), 19);
+
+  auto neg = -(lazy(a) - lazy(b)) * lazy(b);
+  EXPECT_EQ(neg.decrypt(*ctx, *keys), 3);
+}
+
+TEST_F(CryptoTestFixture, ExpressionMergesCommonSubexpressions) {
+  auto a = HomomorphicInt::encrypt(6, *ctx, *keys);
+  auto b = HomomorphicInt::encrypt(7, *ctx, *keys);
+
+  // a*b and b*a are one multiplication, plus the addition
+  auto expr = lazy(a) * lazy(b) + lazy(b) * lazy(a);
+  EXPECT_EQ(expr.operationCount(), 2u);
+  EXPECT_EQ(expr.decrypt(*ctx, *keys), 84);
+
+  // Reusing the same node is merged too: (a+b)^2 squares once
+  auto sum = lazy(a) + lazy(b);
+  auto square = sum * sum;
+  EXPECT_EQ(square.operationCount(), 2u);
+  EXPECT_EQ(square.decrypt(*ctx, *keys), 169);
+}
+
+TEST_F(CryptoTestFixture, ExpressionPlainConstants) {
+  auto a = HomomorphicInt::encrypt(10, *ctx, *keys);
+
+  EXPECT_EQ((lazy(a) + 5).decrypt(*ctx, *keys), 15);
+  EXPECT_EQ((lazy(a) - 3).decrypt(*ctx, *keys), 7);
+  EXPECT_EQ((lazy(a) * 4).decrypt(*ctx, *keys), 40);
+  EXPECT_EQ((2 + lazy(a)).decrypt(*ctx, *keys), 12);
+  EXPECT_EQ((25 - lazy(a)).decrypt(*ctx, *keys), 15);
+  EXPECT_EQ((3 * lazy(a) - 1).decrypt(*ctx, *keys), 29);
+
+  // A zero factor mod t would give a transparent ciphertext
+  auto t = static_cast< std::int64_t >(ctx->plainModulus());
+  EXPECT_FALSE((lazy(a) * 0).evaluate(*ctx).isValid());
+  EXPECT_FALSE((lazy(a) * t + 1).evaluate(*ctx).isValid());
+}
+
+TEST_F(CryptoTestFixture, ExpressionRelinearizesWithContextKeys) {
+  auto a = HomomorphicInt::encrypt(2, *ctx, *keys);
+  auto b = HomomorphicInt::encrypt(3, *ctx, *keys);
+  auto c = HomomorphicInt::encrypt(4, *ctx, *keys);
+
+  // Without relin keys products are left unrelinearized
+  auto expr = lazy(a) * lazy(b) + lazy(c);
+  EXPECT_EQ(expr.evaluate(*ctx).size(), 3u);
+
+  ASSERT_TRUE(keys->generateRelinKeys());
+  ctx->setRelinKeys(keys->relinKeys());
+
+  auto result = expr.evaluate(*ctx);
+  EXPECT_EQ(result.size(), 2u);
+  EXPECT_EQ(result.decrypt(*ctx, *keys), 10);
+
+  auto cube = lazy(a) * lazy(b) * lazy(c);
+  auto cubed = cube.evaluate(*ctx);
+  EXPECT_EQ(cubed.size(), 2u);
+  EXPECT_EQ(cubed.decrypt(*ctx, *keys), 24);
+}
+
+TEST_F(CryptoTestFixture, ExpressionOwnsTemporaries) {
+  auto expr = lazy(HomomorphicInt::encrypt(8, *ctx, *keys)) + 1;
+  EXPECT_EQ(expr.decrypt(*ctx, *keys), 9);
+
+  auto leaf = lazy(HomomorphicInt::encrypt(5, *ctx, *keys));
+  auto copy = leaf.evaluate(*ctx);
+  EXPECT_EQ(copy.decrypt(*ctx, *keys), 5);
+  EXPECT_EQ(leaf.operationCount(), 0u);
+}
+
+TEST_F(CryptoTestFixture, ExpressionSerializeAndSession) {
+  auto a = HomomorphicInt::encrypt(9, *ctx, *keys);
+  auto b = HomomorphicInt::encrypt(4, *ctx, *keys);
+  auto expr = lazy(a) - lazy(b);
+
+  auto bytes = expr.serialize(*ctx);
+  ASSERT_FALSE(bytes.empty());
+  HomomorphicInt loaded;
+  ASSERT_TRUE(loaded.deserialize(bytes, *ctx));
+  EXPECT_EQ(loaded.decrypt(*ctx, *keys), 5);
+
+  sealcrypt::CryptoSession session(*ctx, *keys);
+  EXPECT_EQ(expr.decrypt(session), 5);
+}
+
+TEST_F(CryptoTestFixture, ExpressionInvalidLeaf) {
+  HomomorphicInt empty;
+  auto a = HomomorphicInt::encrypt(1, *ctx, *keys);
+  EXPECT_FALSE((lazy(a) + lazy(empty)).evaluate(*ctx).isValid());
+}
+
+TEST_F(CryptoTestFixture, ExpressionMovedFrom) {
+  auto a = HomomorphicInt::encrypt(2, *ctx, *keys);
+  auto b = HomomorphicInt::encrypt(3, *ctx, *keys);
+
+  auto expr = lazy(a) * lazy(b);
+  auto moved = std::move(expr);
+  EXPECT_EQ(moved.decrypt(*ctx, *keys), 6);
+
+  // The node is shared, the moved-from expression still has it
+  EXPECT_EQ(expr.operationCount(), 1u); // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ((expr + lazy(a)).decrypt(*ctx, *keys), 8);
+
+  auto assigned = lazy(b);
+  assigned = std::move(moved);
+  auto difference = moved - lazy(b); // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(difference.decrypt(*ctx, *keys), 3);
+  EXPECT_EQ(assigned.decrypt(*ctx, *keys), 6);
+}
@@ -0,0 +1,95 @@
+// Test: HomomorphicInt move semantics and rvalue operator overloads
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+#include <utility>
+
+using namespace sealcrypt::test;
+
+namespace {
+
+  auto allocations() -> std::uint64_t {
+    return sealcrypt::HomomorphicInt::ciphertextAllocations();
+  }
+
+} // namespace
+
+TEST_F(CryptoTestFixture, MoveConstructAndAssign) {
+  std::int64_t value = randomInt(0, 1000);
+  auto enc = sealcrypt::HomomorphicInt::encrypt(value, *ctx, *keys);
+
+  auto before = allocations();
+  sealcrypt::HomomorphicInt moved(std::move(enc));
+  sealcrypt::HomomorphicInt assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(allocations() - before, 0u) << "moves must not copy ciphertexts";
+
+  EXPECT_FALSE(enc.isValid()); // NOLINT(bugprone-use-after-move)
+  EXPECT_FALSE(moved.isValid()); // NOLINT(bugprone-use-after-move)
+  ASSERT_TRUE(assigned.isValid());
+  EXPECT_EQ(assigned.decrypt(*ctx, *keys), value);
+
+  // a moved-from object can be reassigned and reused
+  enc = assigned; // NOLINT(bugprone-use-after-move)
+  EXPECT_TRUE(enc.isValid());
+  EXPECT_EQ(enc.decrypt(*ctx, *keys), value);
+}
+
+TEST_F(CryptoTestFixture, ChainedExpressionAllocatesOnce) {
+  // decrypt returns values in [0, t), keep every result non-negative
+  std::int64_t a = randomInt(0, 100);
+  std::int64_t b = randomInt(0, 100);
+  std::int64_t c = randomInt(200, 300);
+  std::int64_t d = randomInt(0, 100);
+
+  auto enc_a = sealcrypt::HomomorphicInt::encrypt(a, *ctx, *keys);
+  auto enc_b = sealcrypt::HomomorphicInt::encrypt(b, *ctx, *keys);
+  auto enc_c = sealcrypt::HomomorphicInt::encrypt(c, *ctx, *keys);
+  auto enc_d = sealcrypt::HomomorphicInt::encrypt(d, *ctx, *keys);
+
+  // only a + b allocates, the temporaries absorb the remaining operations
+  auto before = allocations();
+  auto sum = enc_a + enc_b + enc_c - enc_d;
+  EXPECT_EQ(allocations() - before, 1u);
+  EXPECT_EQ(sum.decrypt(*ctx, *keys), a + b + c - d);
+
+  before = allocations();
+  auto product = (enc_a + enc_b) * enc_c;
+  EXPECT_EQ(allocations() - before, 1u);
+  EXPECT_EQ(product.decrypt(*ctx, *keys), (a + b) * c);
+
+  // rvalue on the right-hand side is reused as well
+  before = allocations();
+  auto rhs = enc_c - (enc_a + enc_b);
+  EXPECT_EQ(allocations() - before, 1u);
+  EXPECT_EQ(rhs.decrypt(*ctx, *keys), c - (a + b));
+}
+
+TEST_F(CryptoTestFixture, MovedOperandRunsInPlace) {
+  // keep ((a + b) * 3 + 7)^2 below the plain modulus
+  std::int64_t a = randomInt(5, 10);
+  std::int64_t b = randomInt(0, 5);
+
+  auto enc_a = sealcrypt::HomomorphicInt::encrypt(a, *ctx, *keys);
+  auto enc_b = sealcrypt::HomomorphicInt::encrypt(b, *ctx, *keys);
+
+  auto before = allocations();
+  auto result = -(std::move(enc_a) + enc_b).mulPlain(3, *ctx).addPlain(7, *ctx);
+  result = std::move(result).square(*ctx);
+  EXPECT_EQ(allocations() - before, 0u);
+
+  std::int64_t inner = (a + b) * 3 + 7;
+  EXPECT_EQ(result.decrypt(*ctx, *keys), inner * inner);
+}
+
+TEST(HomomorphicIntTest, MovedFromIsEmpty) {
+  sealcrypt::HomomorphicInt source;
+  sealcrypt::HomomorphicInt target(std::move(source));
+
+  EXPECT_FALSE(source.isValid()); // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(source.size(), 0u);
+  EXPECT_FALSE((source + target).isValid());
+  EXPECT_FALSE(source.getLastError().empty());
+}
@@ -0,0 +1,121 @@
+// Test: estimatedNoiseBudget(), depth() and level()
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+namespace {
+
+  // Medium leaves room for a couple of products and a mod switch
+  class NoiseEstimateTest : public MediumCryptoTestFixture {
+  protected:
+    auto SetUp() -> void override {
+      MediumCryptoTestFixture::SetUp();
+      if(HasFatalFailure()) {
+        return;
+      }
+      ASSERT_TRUE(keys->generateRelinKeys());
+    }
+
+    auto topLevel() const -> std::size_t {
+      return ctx->sealContext().first_context_data()->chain_index();
+    }
+  };
+
+} // namespace
+
+TEST_F(NoiseEstimateTest, FreshCiphertext) {
+  auto enc = sealcrypt::HomomorphicInt::encrypt(7, *ctx, *keys);
+  EXPECT_EQ(enc.depth(), 0U);
+  EXPECT_EQ(enc.level(), topLevel());
+  EXPECT_GT(enc.estimatedNoiseBudget(), 0);
+  EXPECT_LE(enc.estimatedNoiseBudget(), enc.noiseBudget(*ctx, *keys));
+
+  sealcrypt::HomomorphicInt empty;
+  EXPECT_EQ(empty.depth(), 0U);
+  EXPECT_EQ(empty.level(), 0U);
+  EXPECT_EQ(empty.estimatedNoiseBudget(), 0);
+}
+
+TEST_F(NoiseEstimateTest, OperatorsTrackDepthAndBudget) {
+  auto a = sealcrypt::HomomorphicInt::encrypt(3, *ctx, *keys);
+  auto b = sealcrypt::HomomorphicInt::encrypt(4, *ctx, *keys);
+  auto c = sealcrypt::HomomorphicInt::encrypt(5, *ctx, *keys);
+
+  auto sum = a + b;
+  EXPECT_EQ(sum.depth(), 0U);
+  EXPECT_LT(sum.estimatedNoiseBudget(), a.estimatedNoiseBudget());
+
+  auto prod = (a * b).relinearize(*ctx, *keys);
+  EXPECT_EQ(prod.depth(), 1U);
+  EXPECT_LT(prod.estimatedNoiseBudget(), sum.estimatedNoiseBudget());
+  EXPECT_LE(prod.estimatedNoiseBudget(), prod.noiseBudget(*ctx, *keys));
+
+  auto deeper = (prod * c).relinearize(*ctx, *keys) + a;
+  EXPECT_EQ(deeper.depth(), 2U);
+  EXPECT_LT(deeper.estimatedNoiseBudget(), prod.estimatedNoiseBudget());
+  EXPECT_LE(deeper.estimatedNoiseBudget(), deeper.noiseBudget(*ctx, *keys));
+  EXPECT_EQ(deeper.decrypt(*ctx, *keys), 63);
+
+  // In-place and rvalue paths carry the same figures
+  auto inplace = a;
+  inplace *= b;
+  EXPECT_EQ(inplace.depth(), 1U);
+  EXPECT_EQ(inplace.estimatedNoiseBudget(), prod.estimatedNoiseBudget());
+  auto moved = std::move(inplace) + c;
+  EXPECT_EQ(moved.estimatedNoiseBudget(), (prod + c).estimatedNoiseBudget());
+
+  // Plain additions are free, scalars cost their bit width
+  EXPECT_EQ(a.addPlain(9, *ctx).estimatedNoiseBudget(),
+            a.estimatedNoiseBudget());
+  EXPECT_EQ(a.mulPlain(-1, *ctx).estimatedNoiseBudget(),
+            a.estimatedNoiseBudget() - 1);
+  EXPECT_EQ(a.mulPlain(1000, *ctx).estimatedNoiseBudget(),
+            a.estimatedNoiseBudget() - 10);
+}
+
+TEST_F(NoiseEstimateTest, ModSwitchLowersLevel) {
+  auto enc = sealcrypt::HomomorphicInt::encrypt(11, *ctx, *keys);
+  auto switched = enc.modSwitchToNext(*ctx);
+  EXPECT_EQ(switched.level(), topLevel() - 1);
+  EXPECT_LE(switched.estimatedNoiseBudget(), enc.estimatedNoiseBudget());
+  EXPECT_LE(switched.estimatedNoiseBudget(), switched.noiseBudget(*ctx, *keys));
+
+  auto compacted = enc.compact(*ctx);
+  EXPECT_LT(compacted.level(), enc.level());
+  EXPECT_GT(compacted.estimatedNoiseBudget(), 0);
+  EXPECT_EQ(compacted.decrypt(*ctx, *keys), 11);
+}
+
+TEST_F(NoiseEstimateTest, PowerExpressionAndLoad) {
+  auto x = sealcrypt::HomomorphicInt::encrypt(2, *ctx, *keys);
+
+  auto x4 = x.power(4, *ctx, *keys);
+  EXPECT_EQ(x4.depth(), 2U);
+  EXPECT_EQ(x4.estimatedNoiseBudget(),
+            (x.square(*ctx).relinearize(*ctx, *keys).square(*ctx))
+                .estimatedNoiseBudget());
+  auto all = x.powers(3, *ctx, *keys);
+  ASSERT_EQ(all.size(), 3U);
+  EXPECT_EQ(all[0].depth(), 0U);
+  EXPECT_EQ(all[2].depth(), 2U);
+
+  // Lazy evaluation ends where the eager operators would
+  auto y = sealcrypt::HomomorphicInt::encrypt(3, *ctx, *keys);
+  using sealcrypt::lazy;
+  auto lazy_result = (lazy(x) * lazy(y) + lazy(x)).evaluate(*ctx);
+  auto eager_result = x * y + x;
+  EXPECT_EQ(lazy_result.depth(), 1U);
+  EXPECT_EQ(lazy_result.estimatedNoiseBudget(),
+            eager_result.estimatedNoiseBudget());
+
+  // History does not survive serialization, a loaded value counts as fresh
+  sealcrypt::HomomorphicInt loaded;
+  ASSERT_TRUE(loaded.deserialize(x4.serialize(*ctx), *ctx));
+  EXPECT_EQ(loaded.depth(), 0U);
+  EXPECT_EQ(loaded.level(), x4.level());
+  EXPECT_EQ(loaded.estimatedNoiseBudget(), x.estimatedNoiseBudget());
+}
@@ -0,0 +1,118 @@
+// Test: CryptoContext::encodeConstant(), negative plaintext constants and
+// HomomorphicInt::decryptSigned()
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, EncodeConstantReducesModT) {
+  auto t = static_cast< std::int64_t >(ctx->plainModulus());
+
+  EXPECT_EQ((*ctx->encodeConstant(7))[0], 7u);
+  EXPECT_EQ((*ctx->encodeConstant(-1))[0],
+            static_cast< std::uint64_t >(t - 1));
+  EXPECT_EQ((*ctx->encodeConstant(t + 3))[0], 3u);
+  EXPECT_LT((*ctx->encodeConstant(INT64_MIN))[0],
+            static_cast< std::uint64_t >(t));
+}
+
+TEST_F(CryptoTestFixture, EncodeConstantIsCached) {
+  auto t = static_cast< std::int64_t >(ctx->plainModulus());
+
+  auto first = ctx->encodeConstant(42);
+  auto second = ctx->encodeConstant(42);
+  auto wrapped = ctx->encodeConstant(42 + t);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(first.get(), wrapped.get());
+
+  ctx->setConstantCacheCapacity(0);
+  auto uncached = ctx->encodeConstant(42);
+  EXPECT_NE(first.get(), uncached.get());
+  EXPECT_EQ((*uncached)[0], 42u);
+}
+
+TEST_F(CryptoTestFixture, NegativePlainConstants) {
+  auto t = static_cast< std::int64_t >(ctx->plainModulus());
+  // keep a * b below the plain modulus
+  std::int64_t a = randomInt(100, 500);
+  std::int64_t b = randomInt(1, 99);
+
+  auto enc_a = sealcrypt::HomomorphicInt::encrypt(a, *ctx, *keys);
+
+  EXPECT_EQ(enc_a.addPlain(-b, *ctx).decrypt(*ctx, *keys), a - b);
+  EXPECT_EQ(enc_a.subPlain(-b, *ctx).decrypt(*ctx, *keys), a + b);
+  // HomomorphicInt decrypts to [0, t), so -(a * b) shows up as t - a * b
+  EXPECT_EQ(enc_a.mulPlain(-b, *ctx).decrypt(*ctx, *keys), t - a * b);
+}
+
+TEST_F(CryptoTestFixture, EncryptNegativeValue) {
+  auto t = static_cast< std::int64_t >(ctx->plainModulus());
+  std::int64_t value = randomInt(1, 1000);
+
+  auto enc = sealcrypt::HomomorphicInt::encrypt(-value, *ctx, *keys);
+  ASSERT_TRUE(enc.isValid()) << "Error: " << enc.getLastError();
+  EXPECT_EQ(enc.addPlain(value + 5, *ctx).decrypt(*ctx, *keys), 5);
+  EXPECT_EQ(enc.decrypt(*ctx, *keys), t - value);
+}
+
+TEST_F(CryptoTestFixture, DecryptSignedRoundTrips) {
+  auto t = static_cast< std::int64_t >(ctx->plainModulus());
+  std::int64_t a = randomInt(100, 500);
+  std::int64_t k = randomInt(1, 99);
+
+  auto enc_a = sealcrypt::HomomorphicInt::encrypt(a, *ctx, *keys);
+
+  // decrypt() keeps the residue, decryptSigned() matches HomomorphicVector
+  auto product = enc_a.mulPlain(-k, *ctx);
+  EXPECT_EQ(product.decrypt(*ctx, *keys), t - a * k);
+  EXPECT_EQ(product.decryptSigned(*ctx, *keys), -a * k);
+  EXPECT_EQ(product.mulPlain(-1, *ctx).decryptSigned(*ctx, *keys), a * k);
+
+  auto below = enc_a.addPlain(-(a + k), *ctx);
+  EXPECT_EQ(below.decrypt(*ctx, *keys), t - k);
+  EXPECT_EQ(below.decryptSigned(*ctx, *keys), -k);
+  EXPECT_EQ(below.addPlain(k, *ctx).decryptSigned(*ctx, *keys), 0);
+
+  auto negative = sealcrypt::HomomorphicInt::encrypt(-5, *ctx, *keys);
+  EXPECT_EQ(negative.decryptSigned(*ctx, *keys), -5);
+  EXPECT_EQ(sealcrypt::HomomorphicVector::encrypt({-5}, *ctx, *keys)
+                .decrypt(*ctx, *keys)[0],
+            -5);
+
+  sealcrypt::CryptoSession session(*ctx, *keys);
+  EXPECT_EQ(negative.decryptSigned(session), -5);
+
+  // The split sits halfway, like the vector slots
+  const auto half = (t - 1) / 2;
+  EXPECT_EQ(sealcrypt::HomomorphicInt::encrypt(half, *ctx, *keys)
+                .decryptSigned(*ctx, *keys),
+            half);
+  EXPECT_EQ(sealcrypt::HomomorphicInt::encrypt(half + 1, *ctx, *keys)
+                .decryptSigned(*ctx, *keys),
+            half + 1 - t);
+}
+
+TEST_F(CryptoTestFixture, MulPlainByZeroModT) {
+  auto enc = sealcrypt::HomomorphicInt::encrypt(7, *ctx, *keys);
+
+  // Zero mod t would give a transparent ciphertext, which SEAL rejects
+  auto zero = enc.mulPlain(0, *ctx);
+  EXPECT_FALSE(zero.isValid());
+  EXPECT_FALSE(zero.getLastError().empty());
+
+  auto modulus = enc.mulPlain(65537, *ctx);
+  EXPECT_FALSE(modulus.isValid());
+  EXPECT_FALSE(modulus.getLastError().empty());
+
+  auto moved = sealcrypt::HomomorphicInt::encrypt(7, *ctx, *keys)
+                   .mulPlain(65537, *ctx);
+  EXPECT_FALSE(moved.isValid());
+  EXPECT_FALSE(moved.getLastError().empty());
+
+  // The operand is left as it was
+  EXPECT_EQ(enc.mulPlain(2, *ctx).decrypt(*ctx, *keys), 14);
+}
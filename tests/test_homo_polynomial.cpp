@@ -38,3 +38,130 @@ TEST_F(CryptoTestFixture, PolynomialEvaluation) {
       << a << "*" << x << "^2 + " << b << "*" << x << " + " << c << " = "
       << result << ", expected " << expected;
 }
+
+namespace {
+
+  /// p(x) mod t in [0, t) like decrypt(), lowest coefficient first
+  auto evaluatePlain(const std::vector< std::int64_t >& coeffs,
+                     std::int64_t x,
+                     std::int64_t t) -> std::int64_t {
+    std::int64_t result = 0;
+    for(auto it = coeffs.rbegin(); it != coeffs.rend(); ++it) {
+      result = ((result * x + *it) % t + t) % t;
+    }
+    return result;
+  }
+
+} // namespace
+
+TEST_F(CryptoTestFixture, EvaluatePolynomialMatchesHorner) {
+  // Degree 7 reaches depth 3, see test_homo_power.cpp for why Medium
+  ctx = std::make_unique< sealcrypt::CryptoContext >(
+      sealcrypt::SecurityLevel::Medium);
+  ASSERT_TRUE(ctx->isValid());
+  keys = std::make_unique< sealcrypt::KeyPair >(*ctx);
+  ASSERT_TRUE(keys->generate());
+  ASSERT_TRUE(keys->generateRelinKeys());
+  const auto t = static_cast< std::int64_t >(ctx->plainModulus());
+
+  std::int64_t x = 3;
+  auto enc_x = sealcrypt::HomomorphicInt::encrypt(x, *ctx, *keys);
+
+  for(std::size_t degree = 1; degree <= 7; ++degree) {
+    std::vector< std::int64_t > coeffs;
+    for(std::size_t i = 0; i <= degree; ++i) {
+      coeffs.push_back(randomInt(-5, 5));
+    }
+    coeffs.back() = 2; // keep the degree
+
+    auto result = sealcrypt::evaluatePolynomial(enc_x, coeffs, *ctx, *keys);
+    ASSERT_TRUE(result.isValid()) << "degree " << degree;
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result.decrypt(*ctx, *keys), evaluatePlain(coeffs, x, t))
+        << "degree " << degree;
+  }
+}
+
+TEST_F(CryptoTestFixture, EvaluatePolynomialSparseCoefficients) {
+  ASSERT_TRUE(keys->generateRelinKeys());
+
+  auto enc_x = sealcrypt::HomomorphicInt::encrypt(4, *ctx, *keys);
+
+  // x^2 + 5, trailing zeros are ignored
+  std::vector< std::int64_t > coeffs {5, 0, 1, 0, 0};
+  auto result = sealcrypt::evaluatePolynomial(enc_x, coeffs, *ctx, *keys);
+  ASSERT_TRUE(result.isValid());
+  EXPECT_EQ(result.decrypt(*ctx, *keys), 21);
+
+  // Same ax^2 + bx + c as above, through the pointer overload
+  const std::int64_t abc[] = {5, 3, 2};
+  result = sealcrypt::evaluatePolynomial(enc_x, abc, 3, *ctx, *keys);
+  EXPECT_EQ(result.decrypt(*ctx, *keys), 49);
+}
+
+TEST_F(CryptoTestFixture, EvaluatePolynomialRejects) {
+  auto enc_x = sealcrypt::HomomorphicInt::encrypt(4, *ctx, *keys);
+  std::vector< std::int64_t > coeffs {1, 2, 3};
+
+  // No relin keys
+  EXPECT_FALSE(
+      sealcrypt::evaluatePolynomial(enc_x, coeffs, *ctx, *keys).isValid());
+
+  ASSERT_TRUE(keys->generateRelinKeys());
+  std::vector< std::int64_t > constant {7, 0};
+  EXPECT_FALSE(
+      sealcrypt::evaluatePolynomial(enc_x, constant, *ctx, *keys).isValid());
+  EXPECT_FALSE(sealcrypt::evaluatePolynomial(
+                   sealcrypt::HomomorphicInt(), coeffs, *ctx, *keys)
+                   .isValid());
+}
+
+TEST(PolynomialCost, FewerMultiplicationsThanHorner) {
+  for(std::size_t degree = 1; degree <= 64; ++degree) {
+    auto cost = sealcrypt::polynomialCost(degree);
+    EXPECT_LE(cost.multiplications, degree - 1) << "degree " << degree;
+
+    std::size_t log_depth = 0;
+    while((std::size_t {1} << log_depth) < degree) {
+      ++log_depth;
+    }
+    EXPECT_LE(cost.depth, log_depth + 2) << "degree " << degree;
+  }
+  EXPECT_LT(sealcrypt::polynomialCost(64).multiplications, 24u);
+}
+
+TEST(PolynomialCost, SparseSkipsUnusedGiantSteps) {
+  // Depth 6 needs High's budget
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::High);
+  ASSERT_TRUE(ctx.isValid());
+  const auto t = static_cast< std::int64_t >(ctx.plainModulus());
+
+  // x^64 + 1 only needs the squarings up to x^64
+  std::vector< std::int64_t > coeffs(65, 0);
+  coeffs[0] = 1;
+  coeffs[64] = 1;
+  auto cost = sealcrypt::polynomialCost(coeffs, ctx);
+  EXPECT_EQ(cost.multiplications, 6u);
+  EXPECT_EQ(cost.depth, 6u);
+  EXPECT_LT(cost.multiplications,
+            sealcrypt::polynomialCost(64).multiplications);
+
+  // Every coefficient set costs what the degree alone says
+  std::vector< std::int64_t > dense(65, 1);
+  auto dense_cost = sealcrypt::polynomialCost(dense, ctx);
+  EXPECT_EQ(dense_cost.multiplications,
+            sealcrypt::polynomialCost(64).multiplications);
+  EXPECT_EQ(dense_cost.depth, sealcrypt::polynomialCost(64).depth);
+
+  sealcrypt::KeyPair keys(ctx);
+  ASSERT_TRUE(keys.generate());
+  ASSERT_TRUE(keys.generateRelinKeys());
+  auto enc_x = sealcrypt::HomomorphicInt::encrypt(3, ctx, keys);
+  auto result = sealcrypt::evaluatePolynomial(enc_x, coeffs, ctx, keys);
+  ASSERT_TRUE(result.isValid());
+  EXPECT_EQ(result.decrypt(ctx, keys), evaluatePlain(coeffs, 3, t));
+
+  // No more budget spent than on x^64 alone
+  auto direct = enc_x.power(64, ctx, keys).addPlain(1, ctx);
+  EXPECT_GE(result.noiseBudget(ctx, keys), direct.noiseBudget(ctx, keys));
+}
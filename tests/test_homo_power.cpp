@@ -37,3 +37,70 @@ TEST_F(CryptoTestFixture, Power) {
   EXPECT_EQ(result, expected) << base << "^" << exponent << " = " << result
                               << ", expected " << expected;
 }
+
+TEST(HomomorphicIntTest, PowerDepth) {
+  EXPECT_EQ(sealcrypt::HomomorphicInt::powerDepth(1), 0u);
+  EXPECT_EQ(sealcrypt::HomomorphicInt::powerDepth(2), 1u);
+  EXPECT_EQ(sealcrypt::HomomorphicInt::powerDepth(3), 2u);
+  EXPECT_EQ(sealcrypt::HomomorphicInt::powerDepth(8), 3u);
+  EXPECT_EQ(sealcrypt::HomomorphicInt::powerDepth(9), 4u);
+  EXPECT_EQ(sealcrypt::HomomorphicInt::powerDepth(~std::uint64_t {0}), 64u);
+}
+
+TEST_F(CryptoTestFixture, PowerReportsMissingKeys) {
+  auto enc = sealcrypt::HomomorphicInt::encrypt(3, *ctx, *keys);
+
+  auto result = enc.power(2, *ctx, *keys);
+  EXPECT_FALSE(result.isValid());
+  EXPECT_FALSE(result.getLastError().empty());
+
+  EXPECT_TRUE(enc.powers(4, *ctx, *keys).empty());
+  EXPECT_FALSE(enc.getLastError().empty());
+
+  ASSERT_TRUE(keys->generateRelinKeys());
+  EXPECT_FALSE(enc.power(0, *ctx, *keys).isValid());
+}
+
+TEST_F(MediumCryptoTestFixture, PowerSet) {
+  ASSERT_TRUE(keys->generateRelinKeys());
+
+  auto enc = sealcrypt::HomomorphicInt::encrypt(3, *ctx, *keys);
+  auto powers = enc.powers(8, *ctx, *keys);
+  ASSERT_EQ(powers.size(), 8u);
+
+  std::int64_t expected = 1;
+  for(const auto& power : powers) {
+    expected *= 3;
+    ASSERT_TRUE(power.isValid());
+    EXPECT_EQ(power.size(), 2u);
+    EXPECT_EQ(power.decrypt(*ctx, *keys), expected % 65537);
+  }
+}
+
+TEST(HomomorphicIntTest, PowerModSwitch) {
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::High);
+  ASSERT_TRUE(ctx.isValid());
+  sealcrypt::KeyPair keys(ctx);
+  ASSERT_TRUE(keys.generate());
+  ASSERT_TRUE(keys.generateRelinKeys());
+
+  auto enc = sealcrypt::HomomorphicInt::encrypt(2, ctx, keys);
+  auto full = enc.power(5, ctx, keys);
+
+  sealcrypt::PowerOptions options;
+  options.mod_switch = true;
+  auto lowered = enc.power(5, ctx, keys, options);
+  ASSERT_TRUE(lowered.isValid());
+  EXPECT_EQ(lowered.decrypt(ctx, keys), 32);
+  EXPECT_EQ(full.decrypt(ctx, keys), 32);
+
+  // Dropped below the top level, with budget left for one more product
+  auto level = [&](const sealcrypt::HomomorphicInt& value) {
+    return ctx.sealContext()
+        .get_context_data(value.ciphertext().parms_id())
+        ->chain_index();
+  };
+  EXPECT_LT(level(lowered), level(full));
+  EXPECT_LT(lowered.saveSize(ctx), full.saveSize(ctx));
+  EXPECT_EQ((lowered * lowered).decrypt(ctx, keys), 1024);
+}
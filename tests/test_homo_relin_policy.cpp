@@ -0,0 +1,91 @@
+// Test: CryptoContext::setRelinPolicy() Eager / Lazy / Manual multiplication
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, RelinPolicyNeedsKeys) {
+  EXPECT_EQ(ctx->relinPolicy(), sealcrypt::RelinPolicy::Manual);
+  EXPECT_FALSE(ctx->setRelinPolicy(sealcrypt::RelinPolicy::Eager));
+  EXPECT_FALSE(ctx->hasRelinKeys());
+
+  ASSERT_TRUE(keys->generateRelinKeys());
+  ctx->setRelinKeys(keys->relinKeys());
+  EXPECT_TRUE(ctx->setRelinPolicy(sealcrypt::RelinPolicy::Eager));
+  EXPECT_EQ(ctx->relinPolicy(), sealcrypt::RelinPolicy::Eager);
+}
+
+TEST_F(CryptoTestFixture, RelinPolicyManualGrows) {
+  auto a = sealcrypt::HomomorphicInt::encrypt(6, *ctx, *keys);
+  auto b = sealcrypt::HomomorphicInt::encrypt(7, *ctx, *keys);
+  auto prod = a * b;
+  EXPECT_EQ(prod.size(), 3u);
+  EXPECT_EQ(prod.decrypt(*ctx, *keys), 42);
+}
+
+TEST_F(CryptoTestFixture, RelinPolicyEager) {
+  ASSERT_TRUE(keys->generateRelinKeys());
+  ctx->setRelinKeys(keys->relinKeys());
+  ASSERT_TRUE(ctx->setRelinPolicy(sealcrypt::RelinPolicy::Eager));
+
+  auto a = sealcrypt::HomomorphicInt::encrypt(3, *ctx, *keys);
+  auto b = sealcrypt::HomomorphicInt::encrypt(5, *ctx, *keys);
+
+  auto prod = a * b;
+  EXPECT_EQ(prod.size(), 2u);
+  prod *= a;
+  EXPECT_EQ(prod.size(), 2u);
+  auto sq = b.square(*ctx);
+  EXPECT_EQ(sq.size(), 2u);
+
+  EXPECT_EQ(prod.decrypt(*ctx, *keys), 45);
+  EXPECT_EQ(sq.decrypt(*ctx, *keys), 25);
+}
+
+TEST_F(CryptoTestFixture, RelinPolicyLazy) {
+  ASSERT_TRUE(keys->generateRelinKeys());
+  ctx->setRelinKeys(keys->relinKeys());
+  ASSERT_TRUE(ctx->setRelinPolicy(sealcrypt::RelinPolicy::Lazy));
+
+  auto a = sealcrypt::HomomorphicInt::encrypt(2, *ctx, *keys);
+  auto b = sealcrypt::HomomorphicInt::encrypt(3, *ctx, *keys);
+  auto c = sealcrypt::HomomorphicInt::encrypt(4, *ctx, *keys);
+  auto d = sealcrypt::HomomorphicInt::encrypt(5, *ctx, *keys);
+
+  // The sum of products stays at size 3, one relinearization covers both
+  auto sum = a * b + c * d;
+  EXPECT_EQ(sum.size(), 3u);
+  EXPECT_EQ(sum.decrypt(*ctx, *keys), 26);
+
+  // Multiplying a grown ciphertext relinearizes the operand first. A const
+  // operand is left as it was.
+  auto prod = sum * sum;
+  EXPECT_EQ(prod.size(), 3u);
+  EXPECT_EQ(sum.size(), 3u);
+  EXPECT_EQ(prod.decrypt(*ctx, *keys), 676);
+
+  sum *= a;
+  EXPECT_EQ(sum.size(), 3u);
+  EXPECT_EQ(sum.decrypt(*ctx, *keys), 52);
+
+  // On the wire ciphertexts are always size 2
+  sealcrypt::HomomorphicInt loaded;
+  ASSERT_TRUE(loaded.deserialize(sum.serialize(*ctx), *ctx));
+  EXPECT_EQ(loaded.size(), 2u);
+  EXPECT_EQ(loaded.decrypt(*ctx, *keys), 52);
+}
+
+TEST_F(CryptoTestFixture, RelinPolicyVector) {
+  ASSERT_TRUE(keys->generateRelinKeys());
+  ctx->setRelinKeys(keys->relinKeys());
+  ASSERT_TRUE(ctx->setRelinPolicy(sealcrypt::RelinPolicy::Eager));
+
+  auto a = sealcrypt::HomomorphicVector::encrypt({1, 2, 3}, *ctx, *keys);
+  auto prod = a * a;
+  EXPECT_EQ(prod.ciphertext().size(), 2u);
+  auto values = prod.decrypt(*ctx, *keys);
+  EXPECT_EQ(values[2], 9);
+}
@@ -32,3 +32,26 @@ TEST_F(CryptoTestFixture, SerializeDeserialize) {
   EXPECT_EQ(result, value) << "Deserialized value " << result << " != original "
                            << value;
 }
+
+TEST_F(CryptoTestFixture, SerializeIntoCallerBuffer) {
+  std::int64_t value = randomInt(0, 10000);
+  auto enc = sealcrypt::HomomorphicInt::encrypt(value, *ctx, *keys);
+
+  // Caller-owned arena with room to spare, as an RPC layer would hold it
+  std::vector< std::byte > arena(enc.saveSize(*ctx) + 64);
+  auto written = enc.serializeTo(arena.data(), arena.size(), *ctx);
+  ASSERT_GT(written, 0u) << enc.getLastError();
+  EXPECT_LE(written, enc.saveSize(*ctx));
+
+  // Same bytes as the vector API
+  auto bytes = enc.serialize(*ctx);
+  ASSERT_EQ(bytes.size(), written);
+
+  sealcrypt::HomomorphicInt loaded;
+  ASSERT_TRUE(loaded.deserialize(arena.data(), written, *ctx));
+  EXPECT_EQ(loaded.decrypt(*ctx, *keys), value);
+
+  // Too small a buffer fails without writing past it
+  EXPECT_EQ(enc.serializeTo(arena.data(), 8, *ctx), 0u);
+  EXPECT_FALSE(enc.getLastError().empty());
+}
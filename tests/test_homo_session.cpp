@@ -0,0 +1,62 @@
+// Test: HomomorphicInt encrypt/decrypt/noiseBudget with a CryptoSession
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, SessionEncryptDecrypt) {
+  sealcrypt::CryptoSession session(*ctx, *keys);
+  ASSERT_TRUE(session.isValid()) << "Error: " << session.getLastError();
+  EXPECT_TRUE(session.hasEncryptor());
+  EXPECT_TRUE(session.hasDecryptor());
+
+  for(int i = 0; i < 5; i++) {
+    std::int64_t value = randomInt(0, 10000);
+
+    auto enc = sealcrypt::HomomorphicInt::encrypt(value, session);
+    ASSERT_TRUE(enc.isValid());
+    EXPECT_GT(enc.noiseBudget(session), 0);
+
+    // session and per-call paths must be interchangeable
+    EXPECT_EQ(enc.decrypt(session), value);
+    EXPECT_EQ(enc.decrypt(*ctx, *keys), value);
+  }
+}
+
+TEST(CryptoSessionTest, PublicKeyOnly) {
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Low);
+  sealcrypt::KeyPair full(ctx);
+  ASSERT_TRUE(full.generate());
+  const char* path = "test_session_public.key";
+  ASSERT_TRUE(full.savePublicKey(path));
+
+  sealcrypt::KeyPair public_only(ctx);
+  ASSERT_TRUE(public_only.loadPublicKey(path));
+
+  sealcrypt::CryptoSession session(ctx, public_only);
+  EXPECT_TRUE(session.isValid());
+  EXPECT_TRUE(session.hasEncryptor());
+  EXPECT_FALSE(session.hasDecryptor());
+
+  auto enc = sealcrypt::HomomorphicInt::encrypt(42, session);
+  ASSERT_TRUE(enc.isValid());
+  EXPECT_EQ(enc.decrypt(ctx, full), 42);
+
+  remove(path);
+}
+
+TEST(CryptoSessionTest, NoKeys) {
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Low);
+  sealcrypt::KeyPair keys(ctx);
+
+  sealcrypt::CryptoSession session(ctx, keys);
+  EXPECT_FALSE(session.isValid());
+  EXPECT_FALSE(session.getLastError().empty());
+
+  auto enc = sealcrypt::HomomorphicInt::encrypt(1, session);
+  EXPECT_FALSE(enc.isValid());
+}
@@ -0,0 +1,39 @@
+// Test: HomomorphicInt::encryptSymmetric() seeded ciphertexts
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, SymmetricSeededIsSmaller) {
+  std::int64_t value = randomInt(0, 10000);
+
+  auto seeded = sealcrypt::HomomorphicInt::encryptSymmetric(value, *ctx, *keys);
+  ASSERT_FALSE(seeded.empty());
+
+  auto full =
+      sealcrypt::HomomorphicInt::encrypt(value, *ctx, *keys).serialize(*ctx);
+  EXPECT_LT(seeded.size(), full.size() * 3 / 4)
+      << "Seeded " << seeded.size() << " bytes vs " << full.size();
+
+  // Loading expands the seed into an ordinary ciphertext
+  sealcrypt::HomomorphicInt loaded;
+  ASSERT_TRUE(loaded.deserialize(seeded, *ctx)) << loaded.getLastError();
+  auto sum = loaded.addPlain(5, *ctx);
+  EXPECT_EQ(sum.decrypt(*ctx, *keys), value + 5);
+}
+
+TEST_F(CryptoTestFixture, SymmetricWithSession) {
+  sealcrypt::CryptoSession session(*ctx, *keys);
+  EXPECT_TRUE(session.hasSymmetricEncryptor());
+
+  std::int64_t value = randomInt(0, 10000);
+  auto seeded = sealcrypt::HomomorphicInt::encryptSymmetric(value, session);
+  ASSERT_FALSE(seeded.empty());
+
+  sealcrypt::HomomorphicInt loaded;
+  ASSERT_TRUE(loaded.deserialize(seeded, *ctx)) << loaded.getLastError();
+  EXPECT_EQ(loaded.decrypt(session), value);
+}
@@ -0,0 +1,105 @@
+// Test: KeyPair::saveBundle(), loadBundle() and galoisKeysFor()
+
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+TEST(KeyPairTest, SaveAndLoadBundle) {
+  const char* bundle_path = "test_bundle.keys";
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Medium);
+  sealcrypt::KeyPair client(ctx);
+  ASSERT_TRUE(client.generate());
+  ASSERT_TRUE(client.generateRelinKeys());
+  ASSERT_TRUE(client.generateGaloisKeys(sealcrypt::innerSumSteps(ctx, 4)));
+  ASSERT_TRUE(client.saveBundle(bundle_path))
+      << "Error: " << client.getLastError();
+
+  sealcrypt::KeyPair server(ctx);
+  ASSERT_TRUE(server.loadBundle(bundle_path))
+      << "Error: " << server.getLastError();
+  EXPECT_TRUE(server.hasPublicKey());
+  EXPECT_TRUE(server.hasSecretKey());
+  EXPECT_TRUE(server.hasRelinKeys());
+  EXPECT_TRUE(server.hasGaloisKeys());
+
+  // Only the steps asked for are deserialized
+  EXPECT_EQ(server.galoisKeysFor({1}).size(), 1U);
+  EXPECT_EQ(server.galoisKeysFor({1, 2}).size(), 2U);
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt({1, 2, 3, 4}, ctx, server);
+  auto sum = enc.innerSum(ctx, server, 4);
+  ASSERT_TRUE(sum.isValid()) << enc.getLastError();
+  EXPECT_EQ(sum.decrypt(ctx, client)[0], 10);
+
+  auto a = sealcrypt::HomomorphicInt::encrypt(6, ctx, server);
+  auto b = sealcrypt::HomomorphicInt::encrypt(7, ctx, client);
+  EXPECT_EQ((a * b).relinearize(ctx, server).decrypt(ctx, server), 42);
+
+  // The bundle can be rewritten in place, it is fully read first
+  ASSERT_TRUE(server.saveBundle(bundle_path))
+      << "Error: " << server.getLastError();
+  sealcrypt::KeyPair reloaded(ctx);
+  ASSERT_TRUE(reloaded.loadBundle(bundle_path));
+  EXPECT_EQ(reloaded.galoisKeys().size(), 2U);
+  EXPECT_EQ(enc.decrypt(ctx, reloaded)[3], 4);
+
+  std::remove(bundle_path);
+}
+
+TEST(KeyPairTest, BundleWithoutRequestedStep) {
+  const char* bundle_path = "test_bundle_partial.keys";
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Medium);
+  sealcrypt::KeyPair client(ctx);
+  ASSERT_TRUE(client.generate());
+  ASSERT_TRUE(client.generateGaloisKeys({1, 2, 0}));
+  ASSERT_TRUE(client.saveBundle(bundle_path));
+
+  // A step the bundle lacks pulls in every step
+  sealcrypt::KeyPair server(ctx);
+  ASSERT_TRUE(server.loadBundle(bundle_path));
+  EXPECT_FALSE(server.hasRelinKeys());
+  EXPECT_EQ(server.galoisKeysFor({0}).size(), 1U);
+  EXPECT_EQ(server.galoisKeysFor({5}).size(), 3U);
+
+  std::remove(bundle_path);
+}
+
+TEST(KeyPairTest, BundleErrors) {
+  const char* bundle_path = "test_bundle_errors.keys";
+  const char* other_path = "test_bundle_other.keys";
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Medium);
+  sealcrypt::KeyPair empty(ctx);
+  EXPECT_FALSE(empty.saveBundle(bundle_path));
+  EXPECT_FALSE(empty.getLastError().empty());
+
+  sealcrypt::KeyPair keys(ctx);
+  EXPECT_FALSE(keys.loadBundle("nonexistent_bundle.keys"));
+  EXPECT_FALSE(keys.getLastError().empty());
+
+  {
+    std::ofstream out(other_path, std::ios::binary);
+    out << "not a key bundle";
+  }
+  EXPECT_FALSE(keys.loadBundle(other_path));
+
+  // A bundle for other parameters is rejected before any key is read
+  sealcrypt::CryptoContext low(sealcrypt::SecurityLevel::Low);
+  sealcrypt::KeyPair low_keys(low);
+  ASSERT_TRUE(low_keys.generate());
+  ASSERT_TRUE(low_keys.saveBundle(bundle_path));
+  EXPECT_FALSE(keys.loadBundle(bundle_path));
+  EXPECT_FALSE(keys.hasPublicKey());
+
+  // A failed load keeps the keys held
+  ASSERT_TRUE(keys.generate());
+  EXPECT_FALSE(keys.loadBundle(bundle_path));
+  EXPECT_TRUE(keys.hasSecretKey());
+
+  std::remove(bundle_path);
+  std::remove(other_path);
+}
@@ -0,0 +1,66 @@
+// Test: KeyPair::exportPublicKey() and exportEvaluationKeys()
+
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <gtest/gtest.h>
+
+TEST(KeyPairTest, ExportSeededKeys) {
+  const char* public_path = "test_export_public.key";
+  const char* relin_full_path = "test_export_relin_full.key";
+  const char* relin_path = "test_export_relin.key";
+  const char* galois_full_path = "test_export_galois_full.key";
+  const char* galois_path = "test_export_galois.key";
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Medium);
+  sealcrypt::KeyPair client(ctx);
+  ASSERT_TRUE(client.generate());
+  ASSERT_TRUE(client.generateRelinKeys());
+  ASSERT_TRUE(client.generateGaloisKeys(sealcrypt::innerSumSteps(ctx, 4)));
+
+  ASSERT_TRUE(client.saveRelinKeys(relin_full_path));
+  ASSERT_TRUE(client.saveGaloisKeys(galois_full_path));
+  ASSERT_TRUE(client.exportPublicKey(public_path))
+      << "Error: " << client.getLastError();
+  ASSERT_TRUE(client.exportEvaluationKeys(relin_path, galois_path))
+      << "Error: " << client.getLastError();
+
+  // Seeds replace half of every key
+  namespace fs = std::filesystem;
+  EXPECT_LT(fs::file_size(relin_path) * 10, fs::file_size(relin_full_path) * 6);
+  EXPECT_LT(fs::file_size(galois_path) * 10,
+            fs::file_size(galois_full_path) * 6);
+
+  // A server with only the exported keys computes for the client
+  sealcrypt::KeyPair server(ctx);
+  ASSERT_TRUE(server.loadPublicKey(public_path));
+  ASSERT_TRUE(server.loadRelinKeys(relin_path));
+  ASSERT_TRUE(server.loadGaloisKeys(galois_path));
+  EXPECT_EQ(server.galoisKeys().size(), client.galoisKeys().size());
+
+  auto a = sealcrypt::HomomorphicVector::encrypt({1, 2, 3, 4}, ctx, server);
+  auto b = sealcrypt::HomomorphicVector::encrypt({5, 6, 7, 8}, ctx, server);
+  auto dot = (a * b).relinearize(ctx, server).innerSum(ctx, server, 4);
+  ASSERT_TRUE(dot.isValid());
+  EXPECT_EQ(dot.decrypt(ctx, client)[0], 70);
+
+  for(const auto* path : {public_path,
+                          relin_full_path,
+                          relin_path,
+                          galois_full_path,
+                          galois_path}) {
+    remove(path);
+  }
+}
+
+TEST(KeyPairTest, ExportNeedsGeneratedKeys) {
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Low);
+  sealcrypt::KeyPair keys(ctx);
+  EXPECT_FALSE(keys.exportPublicKey("test_export_unused.key"));
+
+  ASSERT_TRUE(keys.generate());
+  EXPECT_FALSE(keys.exportEvaluationKeys("test_export_unused.key", ""));
+  EXPECT_FALSE(keys.getLastError().empty());
+  EXPECT_TRUE(keys.exportEvaluationKeys("", ""));
+}
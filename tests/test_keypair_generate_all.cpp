@@ -1,4 +1,4 @@
-// Test: KeyPair::generateAll()
+// Test: KeyPair::generateAll() and its thread count
 
 #include "sealcrypt/sealcrypt.hpp"
 
@@ -15,3 +15,27 @@ TEST(KeyPairTest, GenerateAll) {
   EXPECT_TRUE(keys.hasRelinKeys());
   EXPECT_TRUE(keys.hasGaloisKeys());
 }
+
+TEST(KeyPairTest, GenerateAllInParallel) {
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Medium);
+  sealcrypt::KeyPair serial(ctx);
+  sealcrypt::KeyPair parallel(ctx);
+  serial.setThreadCount(1);
+  parallel.setThreadCount(4);
+  EXPECT_EQ(serial.threadCount(), 1U);
+  EXPECT_EQ(parallel.threadCount(), 4U);
+  EXPECT_GE(sealcrypt::KeyPair(ctx).threadCount(), 1U);
+
+  ASSERT_TRUE(serial.generateAll()) << "Error: " << serial.getLastError();
+  ASSERT_TRUE(parallel.generateAll()) << "Error: " << parallel.getLastError();
+  EXPECT_EQ(parallel.galoisKeys().size(), serial.galoisKeys().size());
+  EXPECT_EQ(parallel.relinKeys().size(), serial.relinKeys().size());
+
+  // Keys from every worker belong to the same secret key
+  auto enc = sealcrypt::HomomorphicVector::encrypt({1, 2, 3}, ctx, parallel);
+  auto squared = enc.square(ctx).relinearize(ctx, parallel);
+  auto sum = squared.innerSum(ctx, parallel);
+  ASSERT_TRUE(sum.isValid()) << squared.getLastError();
+  EXPECT_EQ(sum.decrypt(ctx, parallel)[0], 14);
+  EXPECT_EQ(enc.rotateRows(-1, ctx, parallel).decrypt(ctx, parallel)[1], 1);
+}
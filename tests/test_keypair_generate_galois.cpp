@@ -16,3 +16,44 @@ TEST(KeyPairTest, GenerateGaloisKeys) {
 
   EXPECT_TRUE(keys.hasGaloisKeys());
 }
+
+TEST(KeyPairTest, GenerateSelectedGaloisKeys) {
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Low);
+  sealcrypt::KeyPair all(ctx);
+  ASSERT_TRUE(all.generate());
+  ASSERT_TRUE(all.generateGaloisKeys());
+
+  sealcrypt::KeyPair keys(ctx);
+  ASSERT_TRUE(keys.generate());
+  EXPECT_TRUE(keys.generateGaloisKeys({1, 3, 0}))
+      << "Error: " << keys.getLastError();
+  EXPECT_TRUE(keys.hasGaloisKeys());
+  EXPECT_EQ(keys.galoisKeys().size(), 3U);
+  EXPECT_LT(keys.galoisKeys().size(), all.galoisKeys().size());
+
+  sealcrypt::KeyPair no_secret(ctx);
+  EXPECT_FALSE(no_secret.generateGaloisKeys({1}));
+}
+
+TEST(KeyPairTest, RotationPlans) {
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Low);
+  const auto row_size = ctx.slotCount() / 2;
+
+  auto full = sealcrypt::innerSumSteps(ctx);
+  ASSERT_FALSE(full.empty());
+  EXPECT_EQ(full.front(), 1);
+  EXPECT_EQ(static_cast< std::size_t >(full[full.size() - 2]), row_size / 2);
+  EXPECT_EQ(full.back(), 0);
+
+  EXPECT_EQ(sealcrypt::innerSumSteps(ctx, 100),
+            (std::vector< int > {1, 2, 4, 8, 16, 32, 64}));
+  EXPECT_EQ(sealcrypt::innerSumSteps(ctx, 64),
+            (std::vector< int > {1, 2, 4, 8, 16, 32}));
+  EXPECT_TRUE(sealcrypt::innerSumSteps(ctx, 1).empty());
+
+  EXPECT_EQ(sealcrypt::matrixVectorSteps(16),
+            (std::vector< int > {1, 2, 3, 4, 8, 12}));
+  EXPECT_EQ(sealcrypt::matrixVectorSteps(10),
+            (std::vector< int > {1, 2, 3, 4, 8}));
+  EXPECT_TRUE(sealcrypt::matrixVectorSteps(1).empty());
+}
@@ -0,0 +1,65 @@
+// Test: KeyPair::generateEvaluationKeys() from a loaded secret key
+
+#include "sealcrypt/sealcrypt.hpp"
+
+#include <cstdio>
+#include <gtest/gtest.h>
+
+TEST(KeyPairTest, RegenerateFromLoadedSecretKey) {
+  const char* sec_path = "test_regenerate_sec.key";
+  const char* bundle_path = "test_regenerate.keys";
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Medium);
+  sealcrypt::KeyPair client(ctx);
+  ASSERT_TRUE(client.generate());
+  ASSERT_TRUE(client.saveSecretKey(sec_path));
+
+  // The evaluator gets the secret key only and rebuilds the rest
+  sealcrypt::KeyPair server(ctx);
+  ASSERT_TRUE(server.loadSecretKey(sec_path));
+  EXPECT_FALSE(server.hasRelinKeys());
+  ASSERT_TRUE(server.generateEvaluationKeys(sealcrypt::innerSumSteps(ctx)))
+      << "Error: " << server.getLastError();
+  EXPECT_TRUE(server.hasRelinKeys());
+  EXPECT_TRUE(server.hasGaloisKeys());
+
+  auto a = sealcrypt::HomomorphicInt::encrypt(6, ctx, client);
+  auto b = sealcrypt::HomomorphicInt::encrypt(7, ctx, client);
+  EXPECT_EQ((a * b).relinearize(ctx, server).decrypt(ctx, client), 42);
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt({1, 2, 3}, ctx, client);
+  auto sum = enc.innerSum(ctx, server);
+  ASSERT_TRUE(sum.isValid()) << enc.getLastError();
+  EXPECT_EQ(sum.decrypt(ctx, client)[0], 6);
+
+  // A secret key from a bundle works too, and the default set is complete
+  sealcrypt::KeyPair secret_only(ctx);
+  ASSERT_TRUE(secret_only.loadSecretKey(sec_path));
+  ASSERT_TRUE(secret_only.saveBundle(bundle_path));
+  sealcrypt::KeyPair bundled(ctx);
+  ASSERT_TRUE(bundled.loadBundle(bundle_path));
+  ASSERT_TRUE(bundled.generateEvaluationKeys())
+      << "Error: " << bundled.getLastError();
+  EXPECT_EQ(enc.rotateRows(-1, ctx, bundled).decrypt(ctx, client)[3], 3);
+
+  std::remove(sec_path);
+  std::remove(bundle_path);
+}
+
+TEST(KeyPairTest, RegenerateNeedsSecretKey) {
+  const char* pub_path = "test_regenerate_pub.key";
+
+  sealcrypt::CryptoContext ctx(sealcrypt::SecurityLevel::Low);
+  sealcrypt::KeyPair client(ctx);
+  ASSERT_TRUE(client.generate());
+  ASSERT_TRUE(client.savePublicKey(pub_path));
+
+  sealcrypt::KeyPair public_only(ctx);
+  ASSERT_TRUE(public_only.loadPublicKey(pub_path));
+  EXPECT_FALSE(public_only.generateEvaluationKeys());
+  EXPECT_FALSE(public_only.getLastError().empty());
+  EXPECT_FALSE(public_only.generateRelinKeys());
+  EXPECT_FALSE(public_only.generateGaloisKeys());
+
+  std::remove(pub_path);
+}
@@ -0,0 +1,71 @@
+// Test: HomomorphicVector element-wise operators (+, -, *, unary -)
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+namespace {
+
+  auto randomValues(std::size_t count, std::int64_t min, std::int64_t max)
+      -> std::vector< std::int64_t > {
+    static std::mt19937 gen(std::random_device {}());
+    std::uniform_int_distribution< std::int64_t > dist(min, max);
+    std::vector< std::int64_t > values(count);
+    for(auto& value : values) {
+      value = dist(gen);
+    }
+    return values;
+  }
+
+} // namespace
+
+TEST_F(CryptoTestFixture, VectorAddSubMul) {
+  auto a = randomValues(ctx->slotCount(), -100, 100);
+  auto b = randomValues(ctx->slotCount(), -100, 100);
+
+  auto enc_a = sealcrypt::HomomorphicVector::encrypt(a, *ctx, *keys);
+  auto enc_b = sealcrypt::HomomorphicVector::encrypt(b, *ctx, *keys);
+
+  auto sum = (enc_a + enc_b).decrypt(*ctx, *keys);
+  auto diff = (enc_a - enc_b).decrypt(*ctx, *keys);
+  auto prod = (enc_a * enc_b).decrypt(*ctx, *keys);
+
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(sum[i], a[i] + b[i]) << "slot " << i;
+    ASSERT_EQ(diff[i], a[i] - b[i]) << "slot " << i;
+    ASSERT_EQ(prod[i], a[i] * b[i]) << "slot " << i;
+  }
+}
+
+TEST_F(CryptoTestFixture, VectorNegateAndInPlace) {
+  auto a = randomValues(ctx->slotCount(), -100, 100);
+  auto b = randomValues(ctx->slotCount(), -100, 100);
+
+  auto enc_a = sealcrypt::HomomorphicVector::encrypt(a, *ctx, *keys);
+  auto enc_b = sealcrypt::HomomorphicVector::encrypt(b, *ctx, *keys);
+
+  auto neg = (-enc_a).decrypt(*ctx, *keys);
+
+  auto acc = enc_a;
+  acc += enc_b;
+  acc *= enc_b;
+  acc -= enc_a;
+  auto inplace = acc.decrypt(*ctx, *keys);
+
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(neg[i], -a[i]) << "slot " << i;
+    ASSERT_EQ(inplace[i], (a[i] + b[i]) * b[i] - a[i]) << "slot " << i;
+  }
+}
+
+TEST(HomomorphicVectorTest, OperatorsWithInvalidOperands) {
+  sealcrypt::HomomorphicVector invalid1;
+  sealcrypt::HomomorphicVector invalid2;
+
+  EXPECT_FALSE((invalid1 + invalid2).isValid());
+  EXPECT_FALSE((invalid1 * invalid2).isValid());
+  EXPECT_FALSE((-invalid1).isValid());
+}
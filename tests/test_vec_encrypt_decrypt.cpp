@@ -0,0 +1,47 @@
+// Test: HomomorphicVector::encrypt() and decrypt()
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, VectorEncryptDecrypt) {
+  ASSERT_TRUE(ctx->supportsBatching());
+  ASSERT_EQ(ctx->slotCount(), ctx->polyModulusDegree());
+
+  std::vector< std::int64_t > values(ctx->slotCount());
+  for(auto& value : values) {
+    value = randomInt(-1000, 1000);
+  }
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+  ASSERT_TRUE(enc.isValid()) << "Error: " << enc.getLastError();
+
+  auto result = enc.decrypt(*ctx, *keys);
+  EXPECT_EQ(result, values);
+}
+
+TEST_F(CryptoTestFixture, VectorEncryptPadsWithZeros) {
+  std::vector< std::int64_t > values {1, 2, 3};
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+  ASSERT_TRUE(enc.isValid());
+
+  auto result = enc.decrypt(*ctx, *keys);
+  ASSERT_EQ(result.size(), ctx->slotCount());
+  EXPECT_EQ(result[0], 1);
+  EXPECT_EQ(result[1], 2);
+  EXPECT_EQ(result[2], 3);
+  EXPECT_EQ(result[3], 0);
+  EXPECT_EQ(result.back(), 0);
+}
+
+TEST_F(CryptoTestFixture, VectorEncryptTooManyValues) {
+  std::vector< std::int64_t > values(ctx->slotCount() + 1, 1);
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+  EXPECT_FALSE(enc.isValid());
+  EXPECT_FALSE(enc.getLastError().empty());
+}
@@ -0,0 +1,44 @@
+// Test: HomomorphicVector::addPlain(), subPlain(), mulPlain()
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, VectorPlainScalar) {
+  std::vector< std::int64_t > values {5, -7, 100, 0};
+  std::int64_t scalar = randomInt(-50, 50);
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+
+  auto added = enc.addPlain(scalar, *ctx).decrypt(*ctx, *keys);
+  auto subbed = enc.subPlain(scalar, *ctx).decrypt(*ctx, *keys);
+  auto multiplied = enc.mulPlain(3, *ctx).decrypt(*ctx, *keys);
+
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(added[i], values[i] + scalar) << "slot " << i;
+    EXPECT_EQ(subbed[i], values[i] - scalar) << "slot " << i;
+    EXPECT_EQ(multiplied[i], values[i] * 3) << "slot " << i;
+  }
+  // scalar broadcast reaches the padding slots too
+  EXPECT_EQ(added.back(), scalar);
+}
+
+TEST_F(CryptoTestFixture, VectorPlainVector) {
+  std::vector< std::int64_t > values {5, -7, 100, 12};
+  std::vector< std::int64_t > plain {2, 3, -4, 0};
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+
+  auto added = enc.addPlain(plain, *ctx).decrypt(*ctx, *keys);
+  auto subbed = enc.subPlain(plain, *ctx).decrypt(*ctx, *keys);
+  auto multiplied = enc.mulPlain(plain, *ctx).decrypt(*ctx, *keys);
+
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(added[i], values[i] + plain[i]) << "slot " << i;
+    EXPECT_EQ(subbed[i], values[i] - plain[i]) << "slot " << i;
+    EXPECT_EQ(multiplied[i], values[i] * plain[i]) << "slot " << i;
+  }
+}
@@ -0,0 +1,35 @@
+// Test: evaluatePolynomial() on every slot of a HomomorphicVector
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, VectorEvaluatePolynomial) {
+  // see test_homo_power.cpp, depth 2 needs the medium noise budget
+  ctx = std::make_unique< sealcrypt::CryptoContext >(
+      sealcrypt::SecurityLevel::Medium);
+  ASSERT_TRUE(ctx->isValid());
+  keys = std::make_unique< sealcrypt::KeyPair >(*ctx);
+  ASSERT_TRUE(keys->generate());
+  ASSERT_TRUE(keys->generateRelinKeys());
+
+  // 2x^3 - x + 7
+  std::vector< std::int64_t > coeffs {7, -1, 0, 2};
+  std::vector< std::int64_t > values {0, 1, -2, 5, 10};
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+  auto result = sealcrypt::evaluatePolynomial(enc, coeffs, *ctx, *keys);
+  ASSERT_TRUE(result.isValid());
+  EXPECT_EQ(result.size(), 2u);
+
+  auto decrypted = result.decrypt(*ctx, *keys);
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    auto x = values[i];
+    EXPECT_EQ(decrypted[i], 2 * x * x * x - x + 7) << "slot " << i;
+  }
+  // Unused slots hold p(0)
+  EXPECT_EQ(decrypted[values.size()], 7);
+}
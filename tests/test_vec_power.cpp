@@ -0,0 +1,76 @@
+// Test: HomomorphicVector::square(), power(), relinearize()
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sealcrypt::test;
+
+TEST_F(CryptoTestFixture, VectorSquareRelinearize) {
+  ASSERT_TRUE(keys->generateRelinKeys());
+
+  std::vector< std::int64_t > values {3, -4, 12, 100};
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+  auto squared = enc.square(*ctx);
+  EXPECT_EQ(squared.size(), 3);
+
+  auto relin = squared.relinearize(*ctx, *keys);
+  ASSERT_TRUE(relin.isValid());
+  EXPECT_EQ(relin.size(), 2);
+
+  auto result = relin.decrypt(*ctx, *keys);
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(result[i], values[i] * values[i]) << "slot " << i;
+  }
+}
+
+TEST_F(CryptoTestFixture, VectorPower) {
+  // see test_homo_power.cpp, exponentiation needs the medium noise budget
+  ctx = std::make_unique< sealcrypt::CryptoContext >(
+      sealcrypt::SecurityLevel::Medium);
+  ASSERT_TRUE(ctx->isValid());
+  keys = std::make_unique< sealcrypt::KeyPair >(*ctx);
+  ASSERT_TRUE(keys->generate());
+  ASSERT_TRUE(keys->generateRelinKeys());
+
+  std::vector< std::int64_t > values {2, -3, 5, 10};
+
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+  auto cubed = enc.power(3, *ctx, *keys);
+  ASSERT_TRUE(cubed.isValid());
+
+  auto result = cubed.decrypt(*ctx, *keys);
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(result[i], values[i] * values[i] * values[i]) << "slot " << i;
+  }
+}
+
+TEST_F(CryptoTestFixture, VectorPowerSet) {
+  ctx = std::make_unique< sealcrypt::CryptoContext >(
+      sealcrypt::SecurityLevel::Medium);
+  ASSERT_TRUE(ctx->isValid());
+  keys = std::make_unique< sealcrypt::KeyPair >(*ctx);
+  ASSERT_TRUE(keys->generate());
+  ASSERT_TRUE(keys->generateRelinKeys());
+
+  std::vector< std::int64_t > values {2, -3, 5};
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys);
+
+  sealcrypt::PowerOptions options;
+  options.mod_switch = true;
+  auto powers = enc.powers(4, *ctx, *keys, options);
+  ASSERT_EQ(powers.size(), 4u);
+
+  for(std::size_t e = 0; e < powers.size(); ++e) {
+    auto result = powers[e].decrypt(*ctx, *keys);
+    for(std::size_t i = 0; i < values.size(); ++i) {
+      std::int64_t expected = 1;
+      for(std::size_t k = 0; k <= e; ++k) {
+        expected *= values[i];
+      }
+      EXPECT_EQ(result[i], expected) << "x^" << e + 1 << " slot " << i;
+    }
+  }
+}
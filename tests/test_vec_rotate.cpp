@@ -0,0 +1,113 @@
+// Test: HomomorphicVector rotations, innerSum(), dot() and dotPlain()
+
+#include "sealcrypt/sealcrypt.hpp"
+#include "test_fixtures.hpp"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace sealcrypt::test;
+
+namespace {
+
+  // dot() multiplies before a dozen rotations, which Low's budget cannot
+  // take
+  class RotateTest : public MediumCryptoTestFixture {
+  protected:
+    auto SetUp() -> void override {
+      MediumCryptoTestFixture::SetUp();
+      if(HasFatalFailure()) {
+        return;
+      }
+      ASSERT_TRUE(keys->generateRelinKeys());
+      ASSERT_TRUE(keys->generateGaloisKeys());
+      row_size = ctx->slotCount() / 2;
+    }
+
+    std::size_t row_size {0};
+  };
+
+} // namespace
+
+TEST_F(RotateTest, RotateRowsAndColumns) {
+  auto enc = sealcrypt::HomomorphicVector::encrypt({1, 2, 3, 4}, *ctx, *keys);
+
+  auto left = enc.rotateRows(1, *ctx, *keys).decrypt(*ctx, *keys);
+  EXPECT_EQ(left[0], 2);
+  EXPECT_EQ(left[2], 4);
+  EXPECT_EQ(left[3], 0);
+  EXPECT_EQ(left[row_size - 1], 1);
+
+  auto right = enc.rotateRows(-2, *ctx, *keys).decrypt(*ctx, *keys);
+  EXPECT_EQ(right[0], 0);
+  EXPECT_EQ(right[2], 1);
+  EXPECT_EQ(right[5], 4);
+
+  auto swapped = enc.rotateColumns(*ctx, *keys).decrypt(*ctx, *keys);
+  EXPECT_EQ(swapped[0], 0);
+  EXPECT_EQ(swapped[row_size], 1);
+  EXPECT_EQ(swapped[row_size + 3], 4);
+}
+
+TEST_F(RotateTest, InnerSum) {
+  // Values in both rows
+  std::vector< std::int64_t > values(row_size + 100, 0);
+  std::iota(values.begin(), values.begin() + 100, 1);
+  values[row_size + 50] = -7;
+
+  auto sum = sealcrypt::HomomorphicVector::encrypt(values, *ctx, *keys)
+                 .innerSum(*ctx, *keys);
+  ASSERT_TRUE(sum.isValid());
+  auto result = sum.decrypt(*ctx, *keys);
+  EXPECT_EQ(result[0], 5043);
+  EXPECT_EQ(result[row_size - 1], 5043);
+  EXPECT_EQ(result[row_size + 17], 5043);
+}
+
+TEST_F(RotateTest, DotProducts) {
+  auto a = sealcrypt::HomomorphicVector::encrypt({1, 2, 3}, *ctx, *keys);
+  auto b = sealcrypt::HomomorphicVector::encrypt({4, 5, -6}, *ctx, *keys);
+
+  auto dot = a.dot(b, *ctx, *keys);
+  ASSERT_TRUE(dot.isValid()) << a.getLastError();
+  EXPECT_EQ(dot.decrypt(*ctx, *keys)[0], -4);
+
+  // An unrelinearized product is relinearized before it is rotated
+  auto squared = a.square(*ctx);
+  ASSERT_EQ(squared.size(), 3U);
+  EXPECT_EQ(squared.innerSum(*ctx, *keys).decrypt(*ctx, *keys)[7], 14);
+
+  auto weighted = a.dotPlain({10, -1, 2}, *ctx, *keys);
+  ASSERT_TRUE(weighted.isValid()) << a.getLastError();
+  EXPECT_EQ(weighted.decrypt(*ctx, *keys)[row_size], 14);
+}
+
+TEST_F(RotateTest, InnerSumWithPlannedKeys) {
+  // Keys for the plan only: 7 steps instead of every power of two
+  sealcrypt::KeyPair planned(*ctx);
+  ASSERT_TRUE(planned.generate());
+  ASSERT_TRUE(planned.generateGaloisKeys(sealcrypt::innerSumSteps(*ctx, 100)));
+
+  std::vector< std::int64_t > values(100);
+  std::iota(values.begin(), values.end(), 1);
+  auto enc = sealcrypt::HomomorphicVector::encrypt(values, *ctx, planned);
+
+  auto sum = enc.innerSum(*ctx, planned, 100);
+  ASSERT_TRUE(sum.isValid()) << enc.getLastError();
+  EXPECT_EQ(sum.decrypt(*ctx, planned)[0], 5050);
+
+  // The full sum needs keys the plan left out
+  EXPECT_FALSE(enc.innerSum(*ctx, planned).isValid());
+  EXPECT_FALSE(enc.getLastError().empty());
+}
+
+TEST_F(RotateTest, MissingGaloisKeys) {
+  sealcrypt::KeyPair plain_keys(*ctx);
+  ASSERT_TRUE(plain_keys.generate());
+  auto enc = sealcrypt::HomomorphicVector::encrypt({1, 2}, *ctx, plain_keys);
+
+  EXPECT_FALSE(enc.rotateRows(1, *ctx, plain_keys).isValid());
+  EXPECT_FALSE(enc.getLastError().empty());
+  EXPECT_FALSE(enc.innerSum(*ctx, plain_keys).isValid());
+  EXPECT_FALSE(enc.dot(enc, *ctx, plain_keys).isValid());
+}